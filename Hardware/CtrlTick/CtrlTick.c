@@ -0,0 +1,133 @@
+#include "CtrlTick.h"
+
+volatile CtrlTick_Stat CtrlTick_Stats = {0, 0, 0xFFFF, 0, 0, 0, 0};
+
+static struct
+{
+    CtrlTick_Func Func;
+    void *Arg;
+} CtrlTick_List[CTRL_TICK_MAX];
+
+static volatile uint8_t CtrlTick_Num = 0;  // 已登记的控制函数个数
+static int32_t CtrlTick_LastLatency = -1;   // 上次中断延迟，-1表示没有上次数据
+
+/**
+ * @brief  登记控制函数，按登记顺序在每个节拍中依次调用。可在CtrlTick_Init()前后调用。
+ * @param  Func 控制函数。
+ * @param  Arg 调用Func时传入的参数。
+ * @retval 控制函数序号，已满时返回-1
+ */
+int8_t CtrlTick_Register(CtrlTick_Func Func, void *Arg)
+{
+    uint32_t primask;
+    int8_t n = -1;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (CtrlTick_Num < CTRL_TICK_MAX)
+    {
+        n = CtrlTick_Num;
+        CtrlTick_List[n].Func = Func;
+        CtrlTick_List[n].Arg = Arg;
+        CtrlTick_Num = n + 1; // 填好表项后再增加个数，中断中不会调用未填好的表项
+    }
+    __set_PRIMASK(primask);
+    return n;
+}
+
+/**
+ * @brief  清零节拍统计。
+ * @param  无
+ * @retval 无
+ */
+void CtrlTick_ResetStats(void)
+{
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    CtrlTick_Stats.Ticks = 0;
+    CtrlTick_Stats.Overruns = 0;
+    CtrlTick_Stats.LatencyMin = 0xFFFF;
+    CtrlTick_Stats.LatencyMax = 0;
+    CtrlTick_Stats.JitterMax = 0;
+    CtrlTick_Stats.ExecLast = 0;
+    CtrlTick_Stats.ExecMax = 0;
+    CtrlTick_LastLatency = -1;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  初始化并启动TIM3控制节拍，计数频率CTRL_TICK_CLK，更新频率CTRL_TICK_FREQ。
+ * @param  无
+ * @retval 无
+ */
+void CtrlTick_Init(void)
+{
+    TIM_TimeBaseInitTypeDef TIM_TimeBaseStructure;
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM3, ENABLE);
+
+    TIM_TimeBaseStructure.TIM_Period = CTRL_TICK_CLK / CTRL_TICK_FREQ - 1;
+    TIM_TimeBaseStructure.TIM_Prescaler = SystemCoreClock / CTRL_TICK_CLK - 1;
+    TIM_TimeBaseStructure.TIM_ClockDivision = 0;
+    TIM_TimeBaseStructure.TIM_CounterMode = TIM_CounterMode_Up;
+    TIM_TimeBaseInit(TIM3, &TIM_TimeBaseStructure);
+
+    TIM_ClearITPendingBit(TIM3, TIM_IT_Update);
+    TIM_ITConfig(TIM3, TIM_IT_Update, ENABLE);
+
+    NVIC_InitStructure.NVIC_IRQChannel = TIM3_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 1; // 高于OLED刷新和串口，控制周期不受其影响（需NVIC_PriorityGroup_2）
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+
+    CtrlTick_ResetStats();
+    TIM_Cmd(TIM3, ENABLE);
+}
+
+void TIM3_IRQHandler(void)
+{
+    uint16_t latency, exec, jitter;
+    uint8_t i, num;
+
+    if (TIM_GetITStatus(TIM3, TIM_IT_Update) != RESET)
+    {
+        latency = TIM_GetCounter(TIM3); // 更新事件后计数器从0开始，计数值即为中断延迟
+        TIM_ClearITPendingBit(TIM3, TIM_IT_Update);
+
+        num = CtrlTick_Num;
+        for (i = 0; i < num; i++)
+            CtrlTick_List[i].Func(CtrlTick_List[i].Arg, CTRL_TICK_DT);
+
+        if (TIM_GetITStatus(TIM3, TIM_IT_Update) != RESET) // 已进入下一个周期
+        {
+            CtrlTick_Stats.Overruns++;
+            exec = CTRL_TICK_CLK / CTRL_TICK_FREQ - 1;
+        }
+        else
+        {
+            exec = TIM_GetCounter(TIM3) - latency;
+        }
+
+        // 统计
+        CtrlTick_Stats.Ticks++;
+        CtrlTick_Stats.ExecLast = exec;
+        if (exec > CtrlTick_Stats.ExecMax)
+            CtrlTick_Stats.ExecMax = exec;
+        if (latency < CtrlTick_Stats.LatencyMin)
+            CtrlTick_Stats.LatencyMin = latency;
+        if (latency > CtrlTick_Stats.LatencyMax)
+            CtrlTick_Stats.LatencyMax = latency;
+        if (CtrlTick_LastLatency >= 0)
+        {
+            jitter = (latency > CtrlTick_LastLatency) ? latency - CtrlTick_LastLatency
+                                                      : CtrlTick_LastLatency - latency;
+            if (jitter > CtrlTick_Stats.JitterMax)
+                CtrlTick_Stats.JitterMax = jitter;
+        }
+        CtrlTick_LastLatency = latency;
+    }
+}
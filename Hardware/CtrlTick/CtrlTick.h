@@ -0,0 +1,77 @@
+#ifndef __CTRLTICK_H
+#define __CTRLTICK_H
+#include "stm32f10x.h"
+
+/**
+ * 固定频率控制节拍。
+ * 由TIM3更新中断以CTRL_TICK_FREQ的频率依次调用已登记的控制函数，控制周期不受主循环中OLED、串口等任务耗时的影响。
+ * TIM3中断抢占优先级为1，高于OLED后台刷新（TIM4）和串口，控制函数应只做采样、运算和输出，不要调用阻塞函数。
+ * 抢占优先级须在main开头调用NVIC_PriorityGroupConfig(NVIC_PriorityGroup_2)后才有效，
+ * 复位默认的分组0没有抢占优先级位，所有中断都不能互相抢占。
+ */
+#define CTRL_TICK_FREQ 1000   // 控制节拍频率（Hz）
+#define CTRL_TICK_CLK 4000000 // TIM3计数频率（Hz），统计数据的时间单位为 1 / CTRL_TICK_CLK 秒
+#define CTRL_TICK_MAX 8       // 最多登记的控制函数个数
+
+#if (72000000 % CTRL_TICK_CLK) != 0 || (CTRL_TICK_CLK / CTRL_TICK_FREQ) > 65536 || (CTRL_TICK_CLK / CTRL_TICK_FREQ) < 2
+#error "CTRL_TICK_CLK must divide 72MHz and CTRL_TICK_CLK / CTRL_TICK_FREQ must be 2 ~ 65536! See CtrlTick.h file."
+#endif
+
+#define CTRL_TICK_DT (1.0f / CTRL_TICK_FREQ)                      // 控制周期（s）
+#define CTRL_TICK_TO_US(x) ((float)(x) * 1000000.0f / CTRL_TICK_CLK) // 统计数据换算为us
+
+/**
+ * 控制函数，在TIM3中断中调用。
+ * Arg: 登记时传入的参数（一般为控制对象）；dt: 控制周期（s），固定为CTRL_TICK_DT。
+ */
+typedef void (*CtrlTick_Func)(void *Arg, float dt);
+
+/**
+ * 节拍统计，时间单位为TIM3计数值（1 / CTRL_TICK_CLK 秒），换算为us可用CTRL_TICK_TO_US()。
+ * 延迟：从TIM3更新事件到进入中断读取计数值的时间；抖动：相邻两次延迟之差，即实际控制周期与标称周期之差。
+ */
+typedef struct
+{
+    uint32_t Ticks;       // 节拍次数
+    uint32_t Overruns;    // 控制函数总耗时超过一个周期的次数
+    uint16_t LatencyMin;  // 最小中断延迟
+    uint16_t LatencyMax;  // 最大中断延迟
+    uint16_t JitterMax;   // 最大周期抖动（绝对值）
+    uint16_t ExecLast;    // 最近一次控制函数总耗时
+    uint16_t ExecMax;     // 控制函数总耗时最大值
+} CtrlTick_Stat;
+
+extern volatile CtrlTick_Stat CtrlTick_Stats;
+
+void CtrlTick_Init(void);                                  // 初始化并启动TIM3控制节拍。
+int8_t CtrlTick_Register(CtrlTick_Func Func, void *Arg); // 登记控制函数，返回序号，已满返回-1。
+void CtrlTick_ResetStats(void);                          // 清零节拍统计。
+
+#endif
+
+/**
+  ***************************************************
+  * @example 固定频率电机转速环例程
+  * @brief   转速环在TIM3中断中以1kHz运行，主循环只负责显示和串口
+  ***************************************************
+    PID MotorPID;
+
+    static void MotorLoop(void *Arg, float dt)
+    {
+        float speed = Encoder_GetSpeed();
+        TIM2_PWM_Duty(1, (uint8_t)PID_Compute_dt((PID *)Arg, speed, dt));
+    }
+
+    int main(void)
+    {
+        PID_Init(&MotorPID, 0.015, 14.0, 0.000001, 370, -1850, 1850, 0, 100); // Ki单位1/s，Kd单位s
+        CtrlTick_Register(MotorLoop, &MotorPID);
+        CtrlTick_Init();
+
+        while (1)
+        {
+            OLED_ShowNum(1, 1, (uint32_t)CTRL_TICK_TO_US(CtrlTick_Stats.JitterMax), 4, 8);
+        }
+    }
+  ***************************************************
+  */
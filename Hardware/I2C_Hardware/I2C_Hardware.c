@@ -0,0 +1,293 @@
+#include "stm32f10x.h"
+#include "I2C_Hardware.h"
+
+/**
+ * 传输状态。
+ * 一次写传输的流程：起始信号(SB) -> 从机地址(ADDR) -> 控制字节 -> DMA发送数据 -> 等待最后一个字节发送完成(BTF) -> 停止信号。
+ */
+#define HARD_I2C_IDLE 0      // 空闲
+#define HARD_I2C_WAIT_SB 1   // 已发出起始信号，等待SB
+#define HARD_I2C_WAIT_ADDR 2 // 已发送从机地址，等待ADDR
+#define HARD_I2C_DMA 3       // DMA发送数据中
+#define HARD_I2C_WAIT_BTF 4  // DMA已完成，等待最后一个字节移出
+
+static volatile uint8_t Hard_I2C_State = HARD_I2C_IDLE;
+static uint8_t Hard_I2C_Addr;             // 本次传输的从机地址
+static uint8_t Hard_I2C_Control;          // 本次传输的控制字节
+static void (*Hard_I2C_Done)(void);       // 本次传输完成回调
+static volatile uint32_t Hard_I2C_Errors; // 传输错误次数
+static volatile uint8_t Hard_I2C_Failed;  // 最近一次传输是否出错中止
+static uint32_t Hard_I2C_StopLoops;       // 等待停止信号发出的最大循环次数（约2个SCL周期）
+
+/**
+ * @brief  初始化硬件I2C1（重映射到PB8-SCL、PB9-SDA）及DMA1通道6。
+ * @param  ClockSpeed I2C时钟频率。
+ *     @arg 取值: 1 - 400000
+ * @retval 无
+ */
+void Hard_I2C_Init(uint32_t ClockSpeed)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+    I2C_InitTypeDef I2C_InitStructure;
+    DMA_InitTypeDef DMA_InitStructure;
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB | RCC_APB2Periph_AFIO, ENABLE);
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_I2C1, ENABLE);
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+
+    GPIO_PinRemapConfig(GPIO_Remap_I2C1, ENABLE); // I2C1重映射到PB8/PB9
+
+    GPIO_InitStructure.GPIO_Pin = GPIO_Pin_8 | GPIO_Pin_9;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF_OD; // 复用开漏输出
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_Init(GPIOB, &GPIO_InitStructure);
+
+    I2C_DeInit(I2C1);
+    I2C_InitStructure.I2C_Mode = I2C_Mode_I2C;
+    I2C_InitStructure.I2C_DutyCycle = I2C_DutyCycle_2;
+    I2C_InitStructure.I2C_OwnAddress1 = 0x00;
+    I2C_InitStructure.I2C_Ack = I2C_Ack_Enable;
+    I2C_InitStructure.I2C_AcknowledgedAddress = I2C_AcknowledgedAddress_7bit;
+    I2C_InitStructure.I2C_ClockSpeed = ClockSpeed;
+    I2C_Init(I2C1, &I2C_InitStructure);
+    I2C_Cmd(I2C1, ENABLE);
+
+    // DMA1通道6：内存 -> I2C1_DR
+    DMA_DeInit(DMA1_Channel6);
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&I2C1->DR;
+    DMA_InitStructure.DMA_MemoryBaseAddr = 0;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralDST;
+    DMA_InitStructure.DMA_BufferSize = 1;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_Medium;
+    DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+    DMA_Init(DMA1_Channel6, &DMA_InitStructure);
+    DMA_ITConfig(DMA1_Channel6, DMA_IT_TC, ENABLE);
+
+    NVIC_InitStructure.NVIC_IRQChannel = DMA1_Channel6_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 2;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 2;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+
+    NVIC_InitStructure.NVIC_IRQChannel = I2C1_EV_IRQn;
+    NVIC_Init(&NVIC_InitStructure);
+
+    NVIC_InitStructure.NVIC_IRQChannel = I2C1_ER_IRQn;
+    NVIC_Init(&NVIC_InitStructure);
+
+    Hard_I2C_StopLoops = SystemCoreClock / ClockSpeed * 2;
+    Hard_I2C_State = HARD_I2C_IDLE;
+}
+
+/**
+ * @brief  启动一次DMA写传输，函数立即返回，传输在中断中完成。
+ *      注意：传输完成前Data指向的数据必须保持有效。
+ * @param  Addr 从机地址（8位格式，最低位为读写位）。
+ * @param  Control 紧跟从机地址发送的控制字节（OLED中 0x00: 指令，0x40: 数据）。
+ * @param  Data 要发送的数据。
+ * @param  Len 数据长度。
+ *     @arg 取值: 1 - 65535
+ * @param  Mode 数据发送方式。
+ *     @arg 有效取值:
+ *      - \b HARD_I2C_MEM_INC : 依次发送Data中的Len个字节
+ *      - \b HARD_I2C_MEM_REPEAT : 将Data[0]重复发送Len次
+ * @param  Done 传输完成（或出错中止）后在中断中调用的回调函数，不需要时传入0。
+ * @retval 启动状态
+ *      - \b 0 : 已启动
+ *      - \b 1 : 上一次传输尚未完成（或其停止信号尚未发出），未启动
+ */
+uint8_t Hard_I2C_Write(uint8_t Addr, uint8_t Control,
+                       const uint8_t *Data, uint16_t Len,
+                       uint8_t Mode, void (*Done)(void))
+{
+    // STOP位未清除时置位START，F1的I2C可能不发出停止信号或产生错误的起始信号
+    if (Hard_I2C_State != HARD_I2C_IDLE || Len == 0 || (I2C1->CR1 & I2C_CR1_STOP))
+        return 1;
+
+    Hard_I2C_Addr = Addr;
+    Hard_I2C_Control = Control;
+    Hard_I2C_Done = Done;
+    Hard_I2C_Failed = 0;
+
+    DMA_Cmd(DMA1_Channel6, DISABLE);
+    DMA1_Channel6->CMAR = (uint32_t)Data;
+    DMA1_Channel6->CNDTR = Len;
+    if (Mode == HARD_I2C_MEM_REPEAT)
+        DMA1_Channel6->CCR &= ~DMA_MemoryInc_Enable;
+    else
+        DMA1_Channel6->CCR |= DMA_MemoryInc_Enable;
+
+    Hard_I2C_State = HARD_I2C_WAIT_SB;
+    I2C_ITConfig(I2C1, I2C_IT_EVT | I2C_IT_ERR, ENABLE);
+    I2C_GenerateSTART(I2C1, ENABLE);
+    return 0;
+}
+
+/**
+ * @brief  查询硬件I2C是否正在传输。
+ * @param  无
+ * @retval 状态值
+ *      - \b 1 : 正在传输
+ *      - \b 0 : 空闲
+ */
+uint8_t Hard_I2C_IsBusy(void)
+{
+    return (Hard_I2C_State != HARD_I2C_IDLE);
+}
+
+/**
+ * @brief  结束本次传输并调用完成回调。
+ * @param  无
+ * @retval 无
+ */
+static void Hard_I2C_Finish(void)
+{
+    void (*done)(void) = Hard_I2C_Done;
+
+    I2C_ITConfig(I2C1, I2C_IT_EVT | I2C_IT_ERR, DISABLE);
+    Hard_I2C_Done = 0;
+    Hard_I2C_State = HARD_I2C_IDLE;
+
+    if (done)
+        done(); // 回调中可以直接启动下一次传输
+}
+
+/**
+ * @brief  发出停止信号，并等待其实际发出（CR1中的STOP位被硬件清除），最多等待约2个SCL周期。
+ *      超时计入错误次数，此时Hard_I2C_Write()会拒绝启动新的传输，直到STOP位清除。
+ * @param  无
+ * @retval 无
+ */
+static void Hard_I2C_Stop(void)
+{
+    uint32_t n = Hard_I2C_StopLoops;
+
+    I2C_GenerateSTOP(I2C1, ENABLE);
+    while (I2C1->CR1 & I2C_CR1_STOP)
+    {
+        if (n-- == 0)
+        {
+            Hard_I2C_Errors++;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief  中止本次传输：关闭DMA，发出停止信号，计入错误次数，调用完成回调。
+ * @param  无
+ * @retval 无
+ */
+static void Hard_I2C_Abort(void)
+{
+    DMA_Cmd(DMA1_Channel6, DISABLE);
+    I2C_DMACmd(I2C1, DISABLE);
+    Hard_I2C_Stop();
+    Hard_I2C_Errors++;
+    Hard_I2C_Failed = 1;
+    Hard_I2C_Finish();
+}
+
+/**
+ * @brief  等待当前传输完成，最长等待HARD_I2C_TIMEOUT_MS。
+ *      超时（如中断未能响应、从机拉住总线）时中止本次传输并计入错误次数，完成回调在本函数中调用。
+ * @param  无
+ * @retval 状态值
+ *      - \b 0 : 传输完成（或本来就空闲）
+ *      - \b 1 : 超时，传输已中止
+ */
+uint8_t Hard_I2C_Wait(void)
+{
+    uint32_t n = SystemCoreClock / 1000 / 8 * HARD_I2C_TIMEOUT_MS;
+    uint32_t primask;
+
+    while (Hard_I2C_State != HARD_I2C_IDLE)
+    {
+        if (n-- == 0)
+        {
+            primask = __get_PRIMASK();
+            __disable_irq();
+            if (Hard_I2C_State != HARD_I2C_IDLE) // 关中断前传输可能刚好完成
+                Hard_I2C_Abort();
+            __set_PRIMASK(primask);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief  获取最近一次传输的结果，可在完成回调中调用以区分正常完成和出错中止。
+ * @param  无
+ * @retval 状态值
+ *      - \b 0 : 正常完成
+ *      - \b 1 : 出错中止（无应答、总线错误、仲裁丢失或等待超时），数据未完整发送
+ */
+uint8_t Hard_I2C_GetResult(void)
+{
+    return Hard_I2C_Failed;
+}
+
+/**
+ * @brief  获取传输错误（无应答、总线错误、仲裁丢失）次数。
+ * @param  无
+ * @retval 错误次数
+ */
+uint32_t Hard_I2C_GetErrorCount(void)
+{
+    return Hard_I2C_Errors;
+}
+
+void I2C1_EV_IRQHandler(void)
+{
+    uint16_t sr1 = I2C1->SR1;
+
+    if (sr1 & I2C_SR1_SB) // EV5：起始信号已发出
+    {
+        I2C_Send7bitAddress(I2C1, Hard_I2C_Addr, I2C_Direction_Transmitter);
+        Hard_I2C_State = HARD_I2C_WAIT_ADDR;
+    }
+    else if (sr1 & I2C_SR1_ADDR) // EV6：从机应答地址
+    {
+        (void)I2C1->SR2; // 读SR2清除ADDR标志
+        I2C1->DR = Hard_I2C_Control;
+
+        // DMA发送期间关闭事件中断，避免DMA填充间隙产生的BTF被误判为传输结束
+        I2C_ITConfig(I2C1, I2C_IT_EVT, DISABLE);
+        Hard_I2C_State = HARD_I2C_DMA;
+        I2C_DMACmd(I2C1, ENABLE);
+        DMA_Cmd(DMA1_Channel6, ENABLE);
+    }
+    else if ((sr1 & I2C_SR1_BTF) && Hard_I2C_State == HARD_I2C_WAIT_BTF) // EV8_2：最后一个字节已发送
+    {
+        Hard_I2C_Stop(); // 停止信号发出后才能在回调中启动下一次传输
+        Hard_I2C_Finish();
+    }
+}
+
+void I2C1_ER_IRQHandler(void)
+{
+    // 无应答、总线错误或仲裁丢失：中止本次传输
+    I2C_ClearFlag(I2C1, I2C_FLAG_AF | I2C_FLAG_BERR | I2C_FLAG_ARLO | I2C_FLAG_OVR);
+    Hard_I2C_Abort();
+}
+
+void DMA1_Channel6_IRQHandler(void)
+{
+    if (DMA_GetITStatus(DMA1_IT_TC6) != RESET)
+    {
+        DMA_ClearITPendingBit(DMA1_IT_TC6);
+        DMA_Cmd(DMA1_Channel6, DISABLE);
+        I2C_DMACmd(I2C1, DISABLE);
+
+        // 打开事件中断，等待BTF后发送停止信号
+        Hard_I2C_State = HARD_I2C_WAIT_BTF;
+        I2C_ITConfig(I2C1, I2C_IT_EVT, ENABLE);
+    }
+}
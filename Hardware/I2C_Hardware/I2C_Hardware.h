@@ -0,0 +1,34 @@
+#ifndef __I2C_HARDWARE_H
+#define __I2C_HARDWARE_H
+
+#include "stdint.h"
+
+
+/**
+ * 硬件I2C1引脚重映射到 PB8 -> SCL | PB9 -> SDA，与模拟I2C使用相同引脚。
+ * 发送数据由DMA1通道6搬运，起始/地址/停止由I2C1事件中断驱动，整个传输过程不占用CPU。
+ */
+#define HARD_I2C_SPEED 400000 // 默认I2C时钟频率 400kHz
+
+/**
+ * @note Hard_I2C_Wait()的最长等待时间（ms），应大于最长一次传输的时间（400kHz时1024字节约23ms）。
+ *      按每次循环约8个CPU时钟周期估算，不依赖SysTick，关中断或在中断中调用时同样有效。
+ */
+#define HARD_I2C_TIMEOUT_MS 50
+
+#define HARD_I2C_MEM_INC 0    // 依次发送数据数组中的每个字节
+#define HARD_I2C_MEM_REPEAT 1 // 重复发送数据数组中的第一个字节（用于清屏等填充操作）
+
+
+void Hard_I2C_Init(uint32_t ClockSpeed); // 初始化硬件I2C1及DMA。
+
+uint8_t Hard_I2C_Write(uint8_t Addr, uint8_t Control,
+                       const uint8_t *Data, uint16_t Len,
+                       uint8_t Mode, void (*Done)(void)); // 启动一次DMA写传输。
+
+uint8_t Hard_I2C_IsBusy(void);        // 查询是否正在传输。
+uint8_t Hard_I2C_Wait(void);          // 等待当前传输完成，超时返回1。
+uint8_t Hard_I2C_GetResult(void);     // 获取最近一次传输的结果，出错中止返回1。
+uint32_t Hard_I2C_GetErrorCount(void); // 获取传输错误（无应答、总线错误等）次数。
+
+#endif /* __I2C_HARDWARE_H */
@@ -1,6 +1,39 @@
 #include "stm32f10x.h"
 #include "I2C_Software.h"
 
+static uint32_t Sim_I2C_DelayLoops; // 半周期延时循环次数，由Sim_I2C_SetSpeed计算
+
+/**
+ * @brief  模拟I2C半周期延时。
+ * @param  无
+ * @retval 无
+ */
+static void Sim_I2C_Delay(void)
+{
+    uint32_t n = Sim_I2C_DelayLoops;
+    while (n--)
+    {
+        __NOP();
+    }
+}
+
+/**
+ * @brief  设置模拟I2C时钟频率，根据SystemCoreClock计算半周期延时。
+ *      频率超过CPU能够达到的上限时，以最快速度运行。
+ * @param  Freq SCL时钟频率（Hz）。
+ *     @arg 常用取值: 100000、400000、1000000
+ * @retval 无
+ */
+void Sim_I2C_SetSpeed(uint32_t Freq)
+{
+    uint32_t half = SystemCoreClock / Freq / 2; // 半周期CPU时钟数
+
+    if (half > SIM_I2C_EDGE_CYCLES)
+        Sim_I2C_DelayLoops = (half - SIM_I2C_EDGE_CYCLES) / SIM_I2C_LOOP_CYCLES;
+    else
+        Sim_I2C_DelayLoops = 0;
+}
+
 /**
  * @brief  模拟I2C信号IO口初始化。
  * @param  无
@@ -22,6 +55,8 @@ void Sim_I2C_Init(void)
 
     OLED_W_SCL(1);
     OLED_W_SDA(1);
+
+    Sim_I2C_SetSpeed(SIM_I2C_SPEED);
 }
 
 /**
@@ -33,8 +68,11 @@ void Sim_I2C_Start(void)
 {
     OLED_W_SDA(1);
     OLED_W_SCL(1);
+    Sim_I2C_Delay();
     OLED_W_SDA(0);
+    Sim_I2C_Delay();
     OLED_W_SCL(0);
+    Sim_I2C_Delay();
 }
 
 /**
@@ -45,8 +83,11 @@ void Sim_I2C_Start(void)
 void Sim_I2C_Stop(void)
 {
     OLED_W_SDA(0);
+    Sim_I2C_Delay();
     OLED_W_SCL(1);
+    Sim_I2C_Delay();
     OLED_W_SDA(1);
+    Sim_I2C_Delay();
 }
 
 /**
@@ -59,7 +100,9 @@ uint8_t I2C_Wait_Ack(void)
     uint8_t ack;
     OLED_W_SCL(0);
     OLED_W_SDA(1);
+    Sim_I2C_Delay();
     OLED_W_SCL(1);
+    Sim_I2C_Delay();
 
     if (OLED_R_SDA())
         ack = I2C_NO_ACK;
@@ -87,7 +130,9 @@ void I2C_Send_Ack(uint8_t ack)
     else
         OLED_W_SDA(1);
 
+    Sim_I2C_Delay();
     OLED_W_SCL(1);
+    Sim_I2C_Delay();
     OLED_W_SCL(0);
 }
 
@@ -107,7 +152,9 @@ uint8_t I2C_Read_Byte(uint8_t ack)
     OLED_W_SDA(1);
     for (i = 0; i < 8; i++)
     {
+        Sim_I2C_Delay();
         OLED_W_SCL(1);
+        Sim_I2C_Delay();
         data <<= 1;
 
         if (OLED_R_SDA())
@@ -123,6 +170,8 @@ uint8_t I2C_Read_Byte(uint8_t ack)
 
 /**
  * @brief  I2C发送一个字节。
+ *      每一位的时序为：SCL低电平期间改变SDA -> 延时（数据建立时间）-> SCL拉高 -> 延时 -> SCL拉低，
+ *      即使延时循环次数为0，SDA变化与SCL上升沿之间也至少间隔一次Sim_I2C_Delay()调用。
  * @param  Byte  要发送的一个字节。
  * @retval 无
  */
@@ -132,12 +181,17 @@ void I2C_Send_Byte(uint8_t Byte)
     for (i = 0; i < 8; i++)
     {
         OLED_W_SDA(Byte & (0x80 >> i));
+        Sim_I2C_Delay();
         OLED_W_SCL(1);
+        Sim_I2C_Delay();
         OLED_W_SCL(0);
     }
 
     // while(I2C_Wait_Ack());    //等待从机应答信号
 
-    OLED_W_SCL(1); // 变化时钟信号，不等待从机应答
+    OLED_W_SDA(1); // 释放SDA，变化时钟信号，不等待从机应答
+    Sim_I2C_Delay();
+    OLED_W_SCL(1);
+    Sim_I2C_Delay();
     OLED_W_SCL(0);
 }
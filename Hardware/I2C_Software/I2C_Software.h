@@ -10,20 +10,72 @@
 #define SCL_Pin GPIO_Pin_8 // PB8 -> SCL
 #define SDA_Pin GPIO_Pin_9 // PB9 -> SDA
 
-                                                  
+/**
+ * @note 启用后引脚读写直接访问GPIO的BSRR/BRR/IDR寄存器（单条存储指令），
+ *      注释掉则使用库函数GPIO_WriteBit/GPIO_ReadInputDataBit（每次调用都是一次函数调用）。
+ */
+#define SIM_I2C_FAST_GPIO
+
+/**
+ * @note 模拟I2C默认时钟频率（Hz），常用取值：100000（标准模式）、400000（快速模式）、1000000（快速模式+）。
+ *      SSD1306/SSD1315手册规定的最高频率为400kHz，更高频率需自行验证屏幕是否能正常工作。
+ *      运行时可调用Sim_I2C_SetSpeed()修改。
+ */
+#define SIM_I2C_SPEED 400000
+
+/**
+ * @note 半周期延时的校准参数（CPU时钟周期）。
+ *      发送每一位分为两个半周期：低电平半周期（SCL拉低、计算并写SDA、调用延时，约16周期）和
+ *      高电平半周期（SCL拉高、调用延时，约10周期），两者都含一次Sim_I2C_Delay()调用。
+ *      SIM_I2C_EDGE_CYCLES: 半周期中除延时循环外的平均固定开销（引脚翻转、循环控制、函数调用等）；
+ *      SIM_I2C_LOOP_CYCLES: 延时循环每次迭代消耗的周期数。
+ *      更换编译器、优化等级或Flash等待周期后，可用逻辑分析仪测量SCL频率并调整这两个值。
+ */
+#define SIM_I2C_EDGE_CYCLES 13
+#define SIM_I2C_LOOP_CYCLES 4
+
 #define I2C_ACK 0
 #define I2C_NO_ACK 1
+
+#ifdef SIM_I2C_FAST_GPIO
+#define OLED_R_SDA() ((GPIOX->IDR & SDA_Pin) ? 1 : 0)
+#define OLED_W_SCL(x) ((x) ? (GPIOX->BSRR = SCL_Pin) : (GPIOX->BRR = SCL_Pin))
+#define OLED_W_SDA(x) ((x) ? (GPIOX->BSRR = SDA_Pin) : (GPIOX->BRR = SDA_Pin))
+#else
 #define OLED_R_SDA() GPIO_ReadInputDataBit(GPIOX, SDA_Pin)
 #define OLED_W_SCL(x) GPIO_WriteBit(GPIOX, SCL_Pin, (BitAction)(x))
 #define OLED_W_SDA(x) GPIO_WriteBit(GPIOX, SDA_Pin, (BitAction)(x))
+#endif
 
 
-void Sim_I2C_Init(void);            // 初始化模拟I2C引脚。
-void Sim_I2C_Start(void);           // 模拟I2C起始信号。
-void Sim_I2C_Stop(void);            // 模拟I2C停止信号。
-uint8_t I2C_Wait_Ack(void);         // 等待从机应答信号。
-void I2C_Send_Ack(uint8_t ack);     // 发送应答信号。
-uint8_t I2C_Read_Byte(uint8_t ack); // I2C读取一个字节。
-void I2C_Send_Byte(uint8_t Byte);   // I2C发送一个字节。
+void Sim_I2C_Init(void);              // 初始化模拟I2C引脚。
+void Sim_I2C_SetSpeed(uint32_t Freq); // 设置模拟I2C时钟频率。
+void Sim_I2C_Start(void);             // 模拟I2C起始信号。
+void Sim_I2C_Stop(void);              // 模拟I2C停止信号。
+uint8_t I2C_Wait_Ack(void);           // 等待从机应答信号。
+void I2C_Send_Ack(uint8_t ack);       // 发送应答信号。
+uint8_t I2C_Read_Byte(uint8_t ack);   // I2C读取一个字节。
+void I2C_Send_Byte(uint8_t Byte);     // I2C发送一个字节。
 
 #endif /* __I2C_SOFTWARE_H */
+
+/**
+  ***************************************************
+  * @example I2C_Send_Byte耗时测试例程
+  * @brief   用Delay_Cycles()（delay.h）测量发送一个字节消耗的CPU周期数，
+  *          分别在启用/注释SIM_I2C_FAST_GPIO的情况下编译运行，比较两次结果
+  ***************************************************
+    uint32_t t0, t1, cycles;
+
+    Sim_I2C_Init();
+    Sim_I2C_SetSpeed(SystemCoreClock); // 延时循环次数为0，只测量引脚操作本身的开销
+
+    t0 = Delay_Cycles();
+    I2C_Send_Byte(0xA5);
+    t1 = Delay_Cycles();
+    cycles = t1 - t0;           // 含一次Delay_Cycles()调用的开销，见delay.h例程
+
+    // 恢复总线频率后测量：cycles约为 SystemCoreClock / SIM_I2C_SPEED * 9
+    Sim_I2C_SetSpeed(SIM_I2C_SPEED);
+  ***************************************************
+  */
@@ -0,0 +1,144 @@
+/**
+ * 上位机OLED总线传输统计工具：将OLED.c与计数用的模拟I2C桩函数链接，
+ * 输出初始化、清屏、显示字符等操作产生的I2C传输次数（起始-停止为一次）和字节数（含地址和控制字节）。
+ * baseline两列为同样的写入按旧驱动逐字节发送时的统计：旧驱动每个指令或数据字节单独一次传输
+ * （地址 + 控制字节 + 1字节），即本驱动一次传输的每个有效字节（地址和控制字节之后）折合为3字节的一次传输
+ * （旧驱动显示字符串时逐个字符设置光标，实际次数比baseline还多）。
+ *
+ * 编译（在工程根目录，-IHardware/OLED/Host须在最前，以替换器件头文件）：
+ *   直接写屏：
+ *     gcc -DOLED_BUS_STATS -IHardware/OLED/Host -IHardware/OLED -IHardware/I2C_Software -ISystem Hardware/OLED/Host/oled_bus_stats.c Hardware/OLED/OLED.c -o oled_bus_stats
+ *   显存方式：
+ *     gcc -DOLED_BUS_STATS -DOLED_USE_FRAMEBUFFER -IHardware/OLED/Host -IHardware/OLED -IHardware/I2C_Software -ISystem Hardware/OLED/Host/oled_bus_stats.c Hardware/OLED/OLED.c -o oled_bus_stats_fb
+ * 使用：
+ *   oled_bus_stats
+ *
+ * 桩函数独立统计起始信号和发送的字节数，并与OLED_BusStats核对，不一致时返回1。
+ * 不支持OLED_I2C_HARDWARE和OLED_ASYNC_REFRESH（需要外设寄存器）。
+ */
+#include <stdio.h>
+#include "OLED.h"
+#include "I2C_Software.h"
+
+#if defined(OLED_I2C_HARDWARE) || defined(OLED_ASYNC_REFRESH)
+#error "oled_bus_stats only supports software I2C without OLED_ASYNC_REFRESH!"
+#endif
+
+#ifndef OLED_BUS_STATS
+#error "oled_bus_stats requires -DOLED_BUS_STATS!"
+#endif
+
+static unsigned long Starts, Stops, Bytes;
+static unsigned long Current;                     // 当前传输已发送的字节数
+static unsigned long BaseTransactions, BaseBytes; // 按旧驱动逐字节发送折算的统计
+static uint64_t Ticks;
+static int Mismatch;
+
+/* 模拟I2C桩函数 --------------------------------------------------------------*/
+void Sim_I2C_Init(void)
+{
+}
+
+void Sim_I2C_Start(void)
+{
+    Starts++;
+    Current = 0;
+}
+
+void Sim_I2C_Stop(void)
+{
+    Stops++;
+    if (Current > 2) // 扣除地址和控制字节，每个有效字节在旧驱动中为一次3字节的传输
+    {
+        BaseTransactions += Current - 2;
+        BaseBytes += (Current - 2) * 3;
+    }
+}
+
+void I2C_Send_Byte(uint8_t Byte)
+{
+    (void)Byte;
+    Bytes++;
+    Current++;
+}
+
+/* 时基桩函数：每次查询前进1个节拍，使等待立即结束 -----------------------------*/
+uint64_t Delay_GetTick(void)
+{
+    return Ticks++;
+}
+
+void Delay_ms(uint32_t ms)
+{
+    (void)ms;
+}
+
+/**
+ * @brief  清零统计。
+ * @param  无
+ * @retval 无
+ */
+static void Stats_Reset(void)
+{
+    Starts = Stops = Bytes = 0;
+    BaseTransactions = BaseBytes = 0;
+    OLED_BusStats.Transactions = 0;
+    OLED_BusStats.Bytes = 0;
+}
+
+/**
+ * @brief  输出一项统计，并与OLED_BusStats核对。
+ * @param  Name 操作名称。
+ * @retval 无
+ */
+static void Stats_Print(const char *Name)
+{
+#ifdef OLED_USE_FRAMEBUFFER
+    OLED_Flush();
+#endif
+    printf("%-28s %12lu %8lu %12lu %8lu\n", Name, Starts, Bytes, BaseTransactions, BaseBytes);
+    if (Starts != Stops || Starts != OLED_BusStats.Transactions || Bytes != OLED_BusStats.Bytes)
+    {
+        printf("  mismatch: stops=%lu, OLED_BusStats=%lu/%lu\n",
+               Stops, (unsigned long)OLED_BusStats.Transactions, (unsigned long)OLED_BusStats.Bytes);
+        Mismatch = 1;
+    }
+    Stats_Reset();
+}
+
+int main(void)
+{
+#ifdef OLED_USE_FRAMEBUFFER
+    printf("mode: framebuffer (counts include OLED_Flush)\n");
+#else
+    printf("mode: direct\n");
+#endif
+    printf("%-28s %12s %8s %12s %8s\n", "", "transactions", "bytes", "baseline tx", "bytes");
+
+    Stats_Reset();
+    OLED_Init();
+    Stats_Print("OLED_Init()");
+
+    OLED_Clear();
+    Stats_Print("OLED_Clear() (blank)");
+
+    OLED_ShowChar(1, 1, 'A', 8);
+    Stats_Print("OLED_ShowChar 8x16");
+
+    OLED_ShowChar(1, 1, 'A', 8);
+    Stats_Print("OLED_ShowChar 8x16 (same)");
+
+    OLED_ShowChar(3, 1, 'A', 6);
+    Stats_Print("OLED_ShowChar 6x8");
+
+    OLED_ShowString(1, 1, "Hello World!", 8);
+    Stats_Print("OLED_ShowString 12 x 8x16");
+
+    OLED_ShowNum(4, 1, 1234567890, 10, 6);
+    Stats_Print("OLED_ShowNum 10 x 6x8");
+
+    OLED_Clear();
+    Stats_Print("OLED_Clear() (after text)");
+
+    return Mismatch;
+}
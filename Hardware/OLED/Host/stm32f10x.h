@@ -0,0 +1,10 @@
+/**
+ * 上位机编译OLED.c时代替器件头文件（oled_bus_stats.c使用）。
+ * 模拟I2C、非后台刷新方式下OLED.c不访问任何外设寄存器，只需要标准整数类型。
+ */
+#ifndef __STM32F10x_H
+#define __STM32F10x_H
+
+#include <stdint.h>
+
+#endif
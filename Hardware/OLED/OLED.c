@@ -16,7 +16,94 @@
 #include "stm32f10x.h"
 #include "OLED.h"
 #include "OLED_Font.h"
+#include "profile.h"
+#ifdef OLED_I2C_HARDWARE
+#include "I2C_Hardware.h"
+#else
 #include "I2C_Software.h"
+#endif
+
+#define OLED_ADDR 0x78      // OLED从机地址
+#define OLED_CTRL_CMD 0x00  // 控制字节：后续为指令
+#define OLED_CTRL_DATA 0x40 // 控制字节：后续为数据
+
+#ifdef OLED_USE_FRAMEBUFFER
+/**
+ * OLED显存缓冲区，按页存放，OLED_GRAM[页][列]。
+ * OLED_DirtyS/OLED_DirtyE记录各页自上次刷新以来发生变化的列范围[S, E)，S >= E表示该页无需刷新。
+ */
+uint8_t OLED_GRAM[OLED_PAGE_NUM][OLED_COLUMN_NUM];
+static uint8_t OLED_DirtyS[OLED_PAGE_NUM];
+static uint8_t OLED_DirtyE[OLED_PAGE_NUM];
+#endif
+
+#ifdef OLED_BUS_STATS
+OLED_BusStat OLED_BusStats; // I2C总线传输统计
+#define OLED_BUS_COUNT(n) (OLED_BusStats.Transactions++, OLED_BusStats.Bytes += (n))
+#else
+#define OLED_BUS_COUNT(n)
+#endif
+
+#ifdef OLED_USE_FRAMEBUFFER
+#ifdef OLED_I2C_HARDWARE
+static volatile uint8_t OLED_FlushPage = OLED_PAGE_NUM; // 正在异步刷新的页，OLED_PAGE_NUM表示空闲
+static void OLED_FlushWait(void);
+#endif
+#endif
+
+#ifdef OLED_ASYNC_REFRESH
+/**
+ * 总线占用计数，主程序访问屏幕期间不为0，后台刷新中断检测到占用时跳过本次刷新，
+ * 避免中断在主程序的传输过程中插入另一次传输。
+ */
+static volatile uint8_t OLED_BusLock;
+volatile OLED_RefreshStat OLED_RefreshStats;
+#define OLED_BUS_LOCK() (OLED_BusLock++)
+#define OLED_BUS_UNLOCK() (OLED_BusLock--)
+#else
+#define OLED_BUS_LOCK()
+#define OLED_BUS_UNLOCK()
+#endif
+
+/**
+ * @brief  在一次I2C传输中向OLED屏发送控制字节及一段数据，传输完成后返回。
+ * @param  Control 控制字节。
+ *     @arg 有效取值:
+ *      - \b OLED_CTRL_CMD : 后续字节均为指令
+ *      - \b OLED_CTRL_DATA : 后续字节均为显示数据
+ * @param  Data 要发送的数据。
+ * @param  Len 数据长度。
+ * @param  Repeat 为1时将Data[0]重复发送Len次，为0时依次发送Data中的数据。
+ * @retval 无
+ */
+static void OLED_I2C_Write(uint8_t Control, const uint8_t *Data, uint16_t Len, uint8_t Repeat)
+{
+    OLED_BUS_LOCK();
+#ifdef OLED_I2C_HARDWARE
+#ifdef OLED_USE_FRAMEBUFFER
+    OLED_FlushWait();
+#endif
+    Hard_I2C_Wait();
+    if (Hard_I2C_Write(OLED_ADDR, Control, Data, Len, Repeat ? HARD_I2C_MEM_REPEAT : HARD_I2C_MEM_INC, 0))
+    {
+        OLED_BUS_UNLOCK(); // 上一次传输的停止信号未能发出，本次数据丢弃（已计入Hard_I2C_GetErrorCount()）
+        return;
+    }
+    Hard_I2C_Wait(); // Data可能位于调用者的栈上，必须等待传输完成
+#else
+    uint16_t i;
+    Sim_I2C_Start();
+    I2C_Send_Byte(OLED_ADDR);
+    I2C_Send_Byte(Control);
+    for (i = 0; i < Len; i++)
+    {
+        I2C_Send_Byte(Repeat ? Data[0] : Data[i]);
+    }
+    Sim_I2C_Stop();
+#endif
+    OLED_BUS_COUNT(2 + Len);
+    OLED_BUS_UNLOCK();
+}
 
 /**
  * @brief  向OLED屏发送指令。
@@ -25,11 +112,7 @@
  */
 void OLED_WriteCommand(uint8_t Command)
 {
-    Sim_I2C_Start();
-    I2C_Send_Byte(0x78); // 从机地址
-    I2C_Send_Byte(0x00); // 写命令
-    I2C_Send_Byte(Command);
-    Sim_I2C_Stop();
+    OLED_I2C_Write(OLED_CTRL_CMD, &Command, 1, 0);
 }
 
 /**
@@ -39,25 +122,493 @@ void OLED_WriteCommand(uint8_t Command)
  */
 void OLED_WriteData(uint8_t Data)
 {
-    Sim_I2C_Start();
-    I2C_Send_Byte(0x78); // 从机地址
-    I2C_Send_Byte(0x40); // 写数据
-    I2C_Send_Byte(Data);
-    Sim_I2C_Stop();
+    OLED_I2C_Write(OLED_CTRL_DATA, &Data, 1, 0);
+}
+
+/**
+ * @brief  在一次I2C传输中向OLED屏连续发送多条指令。
+ *      控制字节Co=0，其后的所有字节都被视为指令。
+ * @param  Command 指令数组。
+ * @param  Len 指令个数。
+ * @retval 无
+ */
+void OLED_WriteCommandBurst(const uint8_t *Command, uint8_t Len)
+{
+    OLED_I2C_Write(OLED_CTRL_CMD, Command, Len, 0);
+}
+
+/**
+ * @brief  在一次I2C传输中向OLED屏连续发送多个数据。
+ *      屏幕列地址在每个数据后自动加一（页寻址模式下不跨页）。
+ * @param  Data 数据数组。
+ * @param  Len 数据个数。
+ * @retval 无
+ */
+void OLED_WriteDataBurst(const uint8_t *Data, uint16_t Len)
+{
+    OLED_I2C_Write(OLED_CTRL_DATA, Data, Len, 0);
+}
+
+#ifndef OLED_USE_FRAMEBUFFER
+/**
+ * @brief  在一次I2C传输中向OLED屏连续发送多个相同的数据（启用显存时填充只写显存，不需要本函数）。
+ * @param  Data 要重复发送的数据。
+ * @param  Len 数据个数。
+ * @retval 无
+ */
+static void OLED_WriteDataRepeat(uint8_t Data, uint16_t Len)
+{
+    OLED_I2C_Write(OLED_CTRL_DATA, &Data, Len, 1);
+}
+#endif
+
+/**
+ * @brief  向屏幕指定页的指定列写入一段连续数据。
+ *      启用显存时只写入显存并记录变化范围，内容未变化的字节不会被标记为需要刷新；
+ *      否则直接设置光标并发送到屏幕。
+ * @param  Page 页地址。
+ *     @arg 取值: 0 - 7
+ * @param  Column 起始列地址。
+ *     @arg 取值: 0 - 127
+ * @param  Data 要写入的数据。
+ * @param  Len 数据长度。
+ * @retval 无
+ */
+static void OLED_WriteArea(uint8_t Page, uint8_t Column, const uint8_t *Data, uint8_t Len)
+{
+#ifdef OLED_USE_FRAMEBUFFER
+    uint8_t i, first = 0xFF, last = 0;
+
+    if (Page >= OLED_PAGE_NUM || Column >= OLED_COLUMN_NUM)
+        return;
+    if (Len > OLED_COLUMN_NUM - Column)
+        Len = OLED_COLUMN_NUM - Column; // 裁掉超出屏幕右边界的部分
+
+    for (i = 0; i < Len; i++)
+    {
+        if (OLED_GRAM[Page][Column + i] != Data[i])
+        {
+            OLED_GRAM[Page][Column + i] = Data[i];
+            if (first == 0xFF)
+                first = i;
+            last = i;
+        }
+    }
+    if (first != 0xFF)
+        OLED_MarkDirty(Page, Column + first, Column + last);
+#else
+    OLED_SetCursor(Page, Column);
+    OLED_WriteDataBurst(Data, Len);
+#endif
+}
+
+/**
+ * @brief  将屏幕指定页的指定列填充为同一个值。
+ * @param  Page 页地址。
+ *     @arg 取值: 0 - 7
+ * @param  Column 起始列地址。
+ *     @arg 取值: 0 - 127
+ * @param  Value 填充值。
+ * @param  Len 填充长度。
+ * @retval 无
+ */
+static void OLED_FillArea(uint8_t Page, uint8_t Column, uint8_t Value, uint8_t Len)
+{
+#ifdef OLED_USE_FRAMEBUFFER
+    uint8_t i, first = 0xFF, last = 0;
+
+    if (Page >= OLED_PAGE_NUM || Column >= OLED_COLUMN_NUM)
+        return;
+    if (Len > OLED_COLUMN_NUM - Column)
+        Len = OLED_COLUMN_NUM - Column;
+
+    for (i = 0; i < Len; i++)
+    {
+        if (OLED_GRAM[Page][Column + i] != Value)
+        {
+            OLED_GRAM[Page][Column + i] = Value;
+            if (first == 0xFF)
+                first = i;
+            last = i;
+        }
+    }
+    if (first != 0xFF)
+        OLED_MarkDirty(Page, Column + first, Column + last);
+#else
+    OLED_SetCursor(Page, Column);
+    OLED_WriteDataRepeat(Value, Len);
+#endif
+}
+
+#ifdef OLED_USE_FRAMEBUFFER
+/**
+ * @brief  标记显存指定区域需要刷新。直接修改OLED_GRAM后需调用本函数。
+ * @param  Page 页地址。
+ *     @arg 取值: 0 - 7
+ * @param  ColumnS 起始列地址。
+ *     @arg 取值: 0 - 127
+ * @param  ColumnE 结束列地址（包含）。
+ *      注意：ColumnE必须大于等于ColumnS。
+ *     @arg 取值: 0 - 127
+ * @retval 无
+ */
+void OLED_MarkDirty(uint8_t Page, uint8_t ColumnS, uint8_t ColumnE)
+{
+    if (Page >= OLED_PAGE_NUM)
+        return;
+    if (ColumnE >= OLED_COLUMN_NUM)
+        ColumnE = OLED_COLUMN_NUM - 1;
+
+    if (OLED_DirtyS[Page] >= OLED_DirtyE[Page]) // 该页原本无需刷新
+    {
+        OLED_DirtyS[Page] = ColumnS;
+        OLED_DirtyE[Page] = ColumnE + 1;
+    }
+    else
+    {
+        if (ColumnS < OLED_DirtyS[Page])
+            OLED_DirtyS[Page] = ColumnS;
+        if (ColumnE + 1 > OLED_DirtyE[Page])
+            OLED_DirtyE[Page] = ColumnE + 1;
+    }
+}
+
+#ifdef OLED_I2C_HARDWARE
+#define OLED_FLUSH_FIND 0   // 查找下一个有变化的页
+#define OLED_FLUSH_CURSOR 1 // 当前页的光标设置指令发送中
+#define OLED_FLUSH_DATA 2   // 当前页的显示数据发送中
+
+static uint8_t OLED_FlushCmd[3]; // 异步刷新时当前页的光标设置指令
+static uint8_t OLED_FlushS;      // 异步刷新时当前页的起始列
+static uint8_t OLED_FlushE;      // 异步刷新时当前页的结束列（不含）
+static uint8_t OLED_FlushStep;   // 当前页的刷新步骤，OLED_FLUSH_xxx
+
+static void OLED_FlushDone(void);
+
+/**
+ * @brief  中止异步刷新：把当前页已取出的变化范围放回，使其在下次刷新时重新发送，并将刷新状态置为空闲。
+ * @param  无
+ * @retval 无
+ */
+static void OLED_FlushAbort(void)
+{
+    if (OLED_FlushPage < OLED_PAGE_NUM && OLED_FlushStep != OLED_FLUSH_FIND)
+        OLED_MarkDirty(OLED_FlushPage, OLED_FlushS, OLED_FlushE - 1);
+    OLED_FlushStep = OLED_FLUSH_FIND;
+    OLED_FlushPage = OLED_PAGE_NUM;
+}
+
+/**
+ * @brief  异步刷新的下一步。
+ *      每个变化的页先发送光标设置指令，再发送该页变化范围内的显示数据；
+ *      传输无法启动时中止刷新，变化范围保留到下次刷新。
+ * @param  无
+ * @retval 无
+ */
+static void OLED_FlushNext(void)
+{
+    uint8_t j;
+    while (OLED_FlushPage < OLED_PAGE_NUM)
+    {
+        j = OLED_FlushPage;
+        if (OLED_FlushStep == OLED_FLUSH_CURSOR)
+        {
+            OLED_FlushStep = OLED_FLUSH_DATA;
+            if (Hard_I2C_Write(OLED_ADDR, OLED_CTRL_DATA, &OLED_GRAM[j][OLED_FlushS],
+                               OLED_FlushE - OLED_FlushS, HARD_I2C_MEM_INC, OLED_FlushDone))
+            {
+                OLED_FlushAbort();
+                return;
+            }
+            OLED_BUS_COUNT(2 + OLED_FlushE - OLED_FlushS);
+            return;
+        }
+        if (OLED_FlushStep == OLED_FLUSH_DATA) // 当前页发送完成
+        {
+            OLED_FlushStep = OLED_FLUSH_FIND;
+            OLED_FlushPage++;
+            continue;
+        }
+        if (OLED_DirtyS[j] < OLED_DirtyE[j])
+        {
+            // 在设置光标时取出并清除变化范围，此后的修改会在下次刷新时发送
+            OLED_FlushS = OLED_DirtyS[j];
+            OLED_FlushE = OLED_DirtyE[j];
+            OLED_DirtyS[j] = 0;
+            OLED_DirtyE[j] = 0;
+
+            OLED_FlushCmd[0] = 0xB0 | j;
+            OLED_FlushCmd[1] = 0x10 | ((OLED_FlushS & 0xF0) >> 4);
+            OLED_FlushCmd[2] = 0x00 | (OLED_FlushS & 0x0F);
+            OLED_FlushStep = OLED_FLUSH_CURSOR;
+            if (Hard_I2C_Write(OLED_ADDR, OLED_CTRL_CMD, OLED_FlushCmd, 3, HARD_I2C_MEM_INC, OLED_FlushDone))
+            {
+                OLED_FlushAbort();
+                return;
+            }
+            OLED_BUS_COUNT(2 + 3);
+            return;
+        }
+        OLED_FlushPage++;
+    }
 }
 
 /**
- * @brief  软延时。
+ * @brief  异步刷新中一次传输结束的回调（在I2C/DMA中断中调用）。
+ *      传输出错中止（无应答、总线错误、超时）时放回当前页的变化范围并结束本次刷新，否则继续下一步。
  * @param  无
  * @retval 无
  */
-void OLED_delay(void)
+static void OLED_FlushDone(void)
 {
-    uint32_t i, j;
-    for (i = 0; i < 2000; i++) // 上电延时
+    if (Hard_I2C_GetResult())
+        OLED_FlushAbort();
+    else
+        OLED_FlushNext();
+}
+
+/**
+ * @brief  等待异步刷新结束，最长等待HARD_I2C_TIMEOUT_MS（按每次循环约8个CPU时钟周期估算）。
+ *      超时（如I2C中断不再响应）时强制结束刷新，当前页的变化范围保留到下次刷新。
+ * @param  无
+ * @retval 无
+ */
+static void OLED_FlushWait(void)
+{
+    uint32_t n = SystemCoreClock / 1000 / 8 * HARD_I2C_TIMEOUT_MS;
+    uint32_t primask;
+
+    while (OLED_FlushPage < OLED_PAGE_NUM)
     {
-        for (j = 0; j < 2000; j++)
-            ;
+        if (n-- == 0)
+        {
+            primask = __get_PRIMASK();
+            __disable_irq();
+            OLED_FlushAbort(); // 仍在进行的传输由随后的Hard_I2C_Wait()等待或中止
+            __set_PRIMASK(primask);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief  将显存中自上次刷新以来发生变化的部分发送到屏幕。
+ *      硬件I2C方式下本函数启动DMA传输后立即返回，后续各页在中断中依次发送；
+ *      刷新期间调用其他会访问屏幕的函数将等待刷新结束。
+ * @param  无
+ * @retval 无
+ */
+void OLED_Flush(void)
+{
+    if (OLED_FlushPage < OLED_PAGE_NUM) // 上一次刷新尚未结束，变化部分会在其中或下次刷新时发送
+        return;
+    OLED_BUS_LOCK();
+    Hard_I2C_Wait();
+    OLED_FlushStep = OLED_FLUSH_FIND;
+    OLED_FlushPage = 0;
+    OLED_FlushNext();
+    OLED_BUS_UNLOCK();
+}
+
+/**
+ * @brief  查询显存是否正在刷新到屏幕。
+ * @param  无
+ * @retval 状态值
+ *      - \b 1 : 正在刷新
+ *      - \b 0 : 刷新完成
+ */
+uint8_t OLED_FlushBusy(void)
+{
+    return (OLED_FlushPage < OLED_PAGE_NUM || Hard_I2C_IsBusy());
+}
+#else
+/**
+ * @brief  将显存中自上次刷新以来发生变化的部分发送到屏幕。
+ *      每页只发送一段连续的变化列范围，未变化的页不产生任何总线传输。
+ * @param  无
+ * @retval 无
+ */
+void OLED_Flush(void)
+{
+    uint8_t j;
+    OLED_BUS_LOCK(); // 设置光标和发送数据之间不允许后台刷新插入
+    for (j = 0; j < OLED_PAGE_NUM; j++)
+    {
+        if (OLED_DirtyS[j] < OLED_DirtyE[j])
+        {
+            OLED_SetCursor(j, OLED_DirtyS[j]);
+            OLED_WriteDataBurst(&OLED_GRAM[j][OLED_DirtyS[j]], OLED_DirtyE[j] - OLED_DirtyS[j]);
+            OLED_DirtyS[j] = 0;
+            OLED_DirtyE[j] = 0;
+        }
+    }
+    OLED_BUS_UNLOCK();
+}
+
+/**
+ * @brief  查询显存是否正在刷新到屏幕。模拟I2C方式下刷新是同步完成的。
+ * @param  无
+ * @retval 0
+ */
+uint8_t OLED_FlushBusy(void)
+{
+    return 0;
+}
+#endif
+#endif
+
+#ifdef OLED_ASYNC_REFRESH
+/**
+ * @brief  后台刷新一个片，由TIM4更新中断调用。
+ *      模拟I2C方式：按页轮询，找到有变化的页后发送光标设置指令及最多OLED_SLICE_BYTES个数据，
+ *                   剩余部分留到下次中断；
+ *      硬件I2C方式：DMA空闲时启动一次OLED_Flush()，其余各页由DMA传输完成中断接续发送。
+ *      主程序对显存变化范围的修改与本函数之间不加锁，竞争时只会多刷新一部分列，不会漏刷。
+ * @param  无
+ * @retval 1: 本次发送了数据  0: 无数据需要发送或总线被占用
+ */
+static uint8_t OLED_RefreshSlice(void)
+{
+    if (OLED_BusLock)
+        return 0;
+
+#ifdef OLED_I2C_HARDWARE
+    if (OLED_FlushBusy())
+        return 0;
+    OLED_Flush();
+    return OLED_FlushBusy();
+#else
+    static uint8_t page = 0; // 下一次检查的页
+    uint8_t n, j, s, e;
+    uint8_t cmd[3];
+
+    for (n = 0; n < OLED_PAGE_NUM; n++)
+    {
+        j = page;
+        page = (page + 1) % OLED_PAGE_NUM;
+
+        if (OLED_DirtyS[j] < OLED_DirtyE[j])
+        {
+            s = OLED_DirtyS[j];
+            e = OLED_DirtyE[j];
+            if (e - s > OLED_SLICE_BYTES)
+            {
+                e = s + OLED_SLICE_BYTES;
+                OLED_DirtyS[j] = e; // 剩余部分下次发送
+            }
+            else
+            {
+                OLED_DirtyS[j] = 0;
+                OLED_DirtyE[j] = 0;
+            }
+
+            cmd[0] = 0xB0 | j;
+            cmd[1] = 0x10 | ((s & 0xF0) >> 4);
+            cmd[2] = 0x00 | (s & 0x0F);
+            OLED_I2C_Write(OLED_CTRL_CMD, cmd, 3, 0);
+            OLED_I2C_Write(OLED_CTRL_DATA, &OLED_GRAM[j][s], e - s, 0);
+            return 1;
+        }
+    }
+    return 0;
+#endif
+}
+
+/**
+ * @brief  启动后台刷新定时器TIM4，定时器计数频率1MHz（计数值即为us）。
+ * @param  无
+ * @retval 无
+ */
+static void OLED_Refresh_Init(void)
+{
+    TIM_TimeBaseInitTypeDef TIM_TimeBaseStructure;
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM4, ENABLE);
+
+    TIM_TimeBaseStructure.TIM_Period = 1000000 / OLED_REFRESH_FREQ - 1;
+    TIM_TimeBaseStructure.TIM_Prescaler = SystemCoreClock / 1000000 - 1;
+    TIM_TimeBaseStructure.TIM_ClockDivision = 0;
+    TIM_TimeBaseStructure.TIM_CounterMode = TIM_CounterMode_Up;
+    TIM_TimeBaseInit(TIM4, &TIM_TimeBaseStructure);
+
+    TIM_ClearITPendingBit(TIM4, TIM_IT_Update);
+    TIM_ITConfig(TIM4, TIM_IT_Update, ENABLE);
+
+    NVIC_InitStructure.NVIC_IRQChannel = TIM4_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 3; // 最低优先级，可被控制环和串口中断抢占（需NVIC_PriorityGroup_2）
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 3;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+
+    TIM_Cmd(TIM4, ENABLE);
+}
+
+void TIM4_IRQHandler(void)
+{
+    uint16_t t;
+    if (TIM_GetITStatus(TIM4, TIM_IT_Update) != RESET)
+    {
+        TIM_ClearITPendingBit(TIM4, TIM_IT_Update);
+
+        if (OLED_RefreshSlice())
+        {
+            if (TIM_GetITStatus(TIM4, TIM_IT_Update) != RESET) // 已进入下一个周期
+            {
+                OLED_RefreshStats.Overruns++;
+                t = 1000000 / OLED_REFRESH_FREQ;
+            }
+            else
+            {
+                t = TIM_GetCounter(TIM4);
+            }
+            OLED_RefreshStats.LastSliceUs = t;
+            if (t > OLED_RefreshStats.MaxSliceUs)
+                OLED_RefreshStats.MaxSliceUs = t;
+            OLED_RefreshStats.Slices++;
+        }
+    }
+}
+#endif
+
+static uint8_t OLED_ScrollOn = 0;       // 屏幕是否正在滚动
+static uint8_t OLED_ScrollStopping = 0; // 已停止滚动，等待时间未到
+static uint32_t OLED_ScrollStopTick;    // 停止滚动时的节拍计数
+
+/**
+ * @brief  查询停止滚动后的等待时间是否已到，到达后才能重新配置滚动。
+ *      协程中可先调用OLED_Stop_Scroll()，再用PT_WAIT_UNTIL(pt, OLED_ScrollSettled())等待，
+ *      之后调用OLED_Scroll_*时不再阻塞。
+ * @param  无
+ * @retval 1: 可以配置滚动  0: 正在滚动或等待时间未到
+ */
+uint8_t OLED_ScrollSettled(void)
+{
+    if (OLED_ScrollOn)
+        return 0;
+    if (OLED_ScrollStopping && (uint32_t)Delay_GetTick() - OLED_ScrollStopTick < OLED_SCROLL_SETTLE_TICKS)
+        return 0;
+    OLED_ScrollStopping = 0;
+    return 1;
+}
+
+/**
+ * @brief  停止滚动并等待OLED_SCROLL_SETTLE_TICKS，已停止且等待时间已到时立即返回。
+ *      剩余时间用Delay_ms()等待，不依赖SysTick中断，关中断或在中断中调用时也不会卡死。
+ * @param  无
+ * @retval 无
+ */
+static void OLED_Scroll_Prepare(void)
+{
+    uint32_t elapsed;
+
+    OLED_Stop_Scroll();
+    if (OLED_ScrollStopping)
+    {
+        elapsed = (uint32_t)Delay_GetTick() - OLED_ScrollStopTick;
+        if (elapsed < OLED_SCROLL_SETTLE_TICKS)
+            Delay_ms((OLED_SCROLL_SETTLE_TICKS - elapsed) * 1000 / DELAY_TICK_FREQ);
+        OLED_ScrollStopping = 0;
     }
 }
 
@@ -71,9 +622,11 @@ void OLED_delay(void)
  */
 void OLED_SetCursor(uint8_t Line, uint8_t Column)
 {
-    OLED_WriteCommand(0xB0 | Line);                   // 设置行地址位置
-    OLED_WriteCommand(0x10 | ((Column & 0xF0) >> 4)); // 设置列地址位置高4位
-    OLED_WriteCommand(0x00 | (Column & 0x0F));        // 设置列地址位置低4位
+    uint8_t cmd[3];
+    cmd[0] = 0xB0 | Line;                   // 设置行地址位置
+    cmd[1] = 0x10 | ((Column & 0xF0) >> 4); // 设置列地址位置高4位
+    cmd[2] = 0x00 | (Column & 0x0F);        // 设置列地址位置低4位
+    OLED_WriteCommandBurst(cmd, 3);
 }
 
 /**
@@ -146,14 +699,10 @@ void OLED_Test(OLED_TestMode mode)
  */
 void OLED_Clear(void)
 {
-    uint8_t i, j;
-    for (j = 0; j < 8; j++)
+    uint8_t j;
+    for (j = 0; j < OLED_PAGE_NUM; j++)
     {
-        OLED_SetCursor(j, 0);
-        for (i = 0; i < 128; i++)
-        {
-            OLED_WriteData(0x00);
-        }
+        OLED_FillArea(j, 0, 0x00, OLED_COLUMN_NUM);
     }
 }
 
@@ -168,14 +717,10 @@ void OLED_Clear(void)
  */
 void OLED_ClearLine(uint8_t LineS, uint8_t LineE)
 {
-    uint8_t i, j;
+    uint8_t j;
     for (j = (LineS - 1); j <= (LineE - 1); j++)
     {
-        OLED_SetCursor(j, 0);
-        for (i = 0; i < 128; i++)
-        {
-            OLED_WriteData(0x00);
-        }
+        OLED_FillArea(j, 0, 0x00, OLED_COLUMN_NUM);
     }
 }
 
@@ -206,8 +751,7 @@ void OLED_ClearLine(uint8_t LineS, uint8_t LineE)
  */
 void OLED_Scroll_H(OLED_ScrHorDir ScrLR, uint8_t LineS, uint8_t LineE, OLED_ScrSpeed Speed)
 {
-    OLED_WriteCommand(0x2E); // 关闭滚动
-    OLED_delay();
+    OLED_Scroll_Prepare(); // 关闭滚动并等待
     OLED_WriteCommand((uint8_t)ScrLR); // 水平滚动方向
     OLED_WriteCommand(0x00);           // 空字节，固定0x00
     OLED_WriteCommand(LineS - 1);      // 水平滚动起始行
@@ -216,6 +760,7 @@ void OLED_Scroll_H(OLED_ScrHorDir ScrLR, uint8_t LineS, uint8_t LineE, OLED_ScrS
     OLED_WriteCommand(0x00);           // 空字节，固定0x00
     OLED_WriteCommand(0xFF);           // 空字节，固定0xFF
     OLED_WriteCommand(0x2F);           // 开启滚动
+    OLED_ScrollOn = 1;
 }
 
 #ifdef OLED_SSD1315
@@ -263,8 +808,7 @@ void OLED_Scroll_VH(uint8_t PixLineS, uint8_t PixLineNum,
                     uint8_t ColumnS, uint8_t ColumnE,
                     uint8_t Offset, OLED_ScrSpeed Speed)
 {
-    OLED_WriteCommand(0x2E); // 关闭滚动
-    OLED_delay();
+    OLED_Scroll_Prepare(); // 关闭滚动并等待
     OLED_WriteCommand(0xA3);                // 启用部分区域水平+垂直滚动
     OLED_WriteCommand(PixLineS - 1);        // 垂直滚动起始像素行
     OLED_WriteCommand(PixLineNum - 1);      // 执行垂直滚动的像素行数
@@ -277,6 +821,7 @@ void OLED_Scroll_VH(uint8_t PixLineS, uint8_t PixLineNum,
     OLED_WriteCommand(ColumnS - 1);         // 水平滚动起始列
     OLED_WriteCommand(ColumnE - 1);         // 水平滚动终止列
     OLED_WriteCommand(0x2F);                // 开启滚动
+    OLED_ScrollOn = 1;
 }
 #elif defined(OLED_SSD1306)
 /**
@@ -313,8 +858,7 @@ void OLED_Scroll_VH(OLED_ScrVerHorDir ScrVLR, uint8_t LineS, uint8_t LineE,
                     uint8_t PixLineS, uint8_t PixLineNum,
                     uint8_t Offset, OLED_ScrSpeed Speed)
 {
-    OLED_WriteCommand(0x2E); // 关闭滚动
-    OLED_delay();
+    OLED_Scroll_Prepare(); // 关闭滚动并等待
     OLED_WriteCommand((uint8_t)ScrVLR); // 滚动方向
     OLED_WriteCommand(0x00);            // 空字节，固定0x00
     OLED_WriteCommand(LineS - 1);       // 水平滚动起始行
@@ -325,6 +869,7 @@ void OLED_Scroll_VH(OLED_ScrVerHorDir ScrVLR, uint8_t LineS, uint8_t LineE,
     OLED_WriteCommand(PixLineS - 1);    // 垂直滚动起始像素行
     OLED_WriteCommand(PixLineNum - 1);  // 执行垂直滚动的像素行数
     OLED_WriteCommand(0x2F);            // 开启滚动
+    OLED_ScrollOn = 1;
 }
 #endif
 
@@ -336,6 +881,12 @@ void OLED_Scroll_VH(OLED_ScrVerHorDir ScrVLR, uint8_t LineS, uint8_t LineE,
 void OLED_Stop_Scroll(void)
 {
     OLED_WriteCommand(0x2E); // 关闭滚动
+    if (OLED_ScrollOn)
+    {
+        OLED_ScrollOn = 0;
+        OLED_ScrollStopping = 1;
+        OLED_ScrollStopTick = (uint32_t)Delay_GetTick();
+    }
 }
 
 /**
@@ -346,6 +897,7 @@ void OLED_Stop_Scroll(void)
 void OLED_Start_Scroll(void)
 {
     OLED_WriteCommand(0x2F); // 开启滚动
+    OLED_ScrollOn = 1;
 }
 
 /**
@@ -365,16 +917,17 @@ uint32_t OLED_Pow(uint32_t X, uint32_t Y)
 }
 
 /**
- * @brief  OLED初始化。
- *      PB9 - SDA | PB8 - SCL
+ * @brief  初始化总线接口并发送OLED初始化指令（上电等待之后调用）。
  * @param  无
  * @retval 无
  */
-void OLED_Init(void)
+static void OLED_Init_Seq(void)
 {
-    OLED_delay();
-
+#ifdef OLED_I2C_HARDWARE
+    Hard_I2C_Init(HARD_I2C_SPEED); // 硬件I2C1及DMA初始化
+#else
     Sim_I2C_Init(); // 端口初始化
+#endif
 
     OLED_WriteCommand(0xAE); // 关闭显示
 
@@ -415,6 +968,48 @@ void OLED_Init(void)
     OLED_WriteCommand(0xAF); // 开启显示
 
     OLED_Clear(); // OLED清屏
+
+#ifdef OLED_USE_FRAMEBUFFER
+    // 上电后屏幕内容未知，强制整屏刷新一次使屏幕与显存一致
+    uint8_t j;
+    for (j = 0; j < OLED_PAGE_NUM; j++)
+    {
+        OLED_MarkDirty(j, 0, OLED_COLUMN_NUM - 1);
+    }
+    OLED_Flush();
+#endif
+
+#ifdef OLED_ASYNC_REFRESH
+    OLED_Refresh_Init(); // 此后显存的变化由后台自动刷新
+#endif
+}
+
+/**
+ * @brief  OLED初始化。
+ *      上电等待使用Delay_ms()，不依赖SysTick中断，可在SysTick中断运行之前或在中断中调用。
+ *      PB9 - SDA | PB8 - SCL
+ * @param  无
+ * @retval 无
+ */
+void OLED_Init(void)
+{
+    Delay_ms(OLED_POWERUP_TICKS * 1000 / DELAY_TICK_FREQ); // 等待屏幕上电
+    OLED_Init_Seq();
+}
+
+/**
+ * @brief  OLED初始化（协程版本）。上电等待期间返回PT_WAITING，由调用者反复调用直到返回PT_ENDED，
+ *      等待期间可运行其他任务；之后的初始化指令一次发送完成。需要SysTick中断正常运行。
+ *      PB9 - SDA | PB8 - SCL
+ * @param  pt 协程状态，首次调用前用PT_INIT()初始化
+ * @retval PT_WAITING: 正在等待  PT_ENDED: 初始化完成
+ */
+uint8_t OLED_Init_PT(PT *pt)
+{
+    PT_BEGIN(pt);
+    PT_AWAIT_TICKS(pt, OLED_POWERUP_TICKS); // 等待屏幕上电
+    OLED_Init_Seq();
+    PT_END(pt);
 }
 
 /**
@@ -431,27 +1026,58 @@ void OLED_Init(void)
  */
 void OLED_ShowChar(uint8_t Line, uint8_t Column, int8_t Char, uint8_t Size)
 {
-    uint8_t i;
     if (Size == 8) // 字符大小8x16
     {
-        OLED_SetCursor(Line - 1, Column - 1); // 设置光标位置在上半部分
-        for (i = 0; i < 8; i++)
-        {
-            OLED_WriteData(OLED_F8x16[Char - ' '][i]); // 显示上半部分内容
-        }
-        OLED_SetCursor((Line - 1) + 1, Column - 1); // 设置光标位置在下半部分
-        for (i = 0; i < 8; i++)
-        {
-            OLED_WriteData(OLED_F8x16[Char - ' '][i + 8]); // 显示下半部分内容
-        }
+        OLED_WriteArea(Line - 1, Column - 1, OLED_F8x16[Char - ' '], 8);           // 显示上半部分内容
+        OLED_WriteArea((Line - 1) + 1, Column - 1, OLED_F8x16[Char - ' '] + 8, 8); // 显示下半部分内容
     }
     else // 字符大小6x8
     {
-        OLED_SetCursor(Line - 1, Column - 1);
-        for (i = 0; i < 6; i++)
+        OLED_WriteArea(Line - 1, Column - 1, OLED_F6x8[Char - ' '], 6);
+    }
+}
+
+/**
+ * @brief  将一段字符的字模拼接后显示，每页只写入一次。
+ *      超出屏幕右边界的部分被裁掉。
+ * @param  Line 起始行位置。
+ *     @arg 取值: 1 - 8
+ * @param  Column 起始列位置。
+ *     @arg 取值: 1 - 128
+ * @param  Text 要显示的字符（不要求以'\0'结尾）。
+ * @param  Len 字符个数。
+ * @param  Size 字符大小。
+ *     @arg 取值(宽x高): 6（6x8）、8（8x16）
+ * @retval 无
+ */
+static void OLED_ShowText(uint8_t Line, uint8_t Column, const char *Text, uint8_t Len, uint8_t Size)
+{
+    uint8_t buf[OLED_COLUMN_NUM]; // 一页内拼接好的字模
+    const uint8_t *glyph;
+    uint8_t i, j, k, p, max;
+    uint8_t pages = (Size == 8) ? 2 : 1;
+    uint8_t width = (Size == 8) ? 8 : 6; // 字模宽度，字号不为8时都按6x8显示
+
+    if (Column < 1 || Column > OLED_COLUMN_NUM)
+        return;
+    max = OLED_COLUMN_NUM - (Column - 1); // 本行剩余可显示的列数
+
+    for (p = 0; p < pages; p++)
+    {
+        k = 0;
+        for (i = 0; i < Len && k < max; i++)
         {
-            OLED_WriteData(OLED_F6x8[Char - ' '][i]);
+            if (Size == 8)
+                glyph = OLED_F8x16[Text[i] - ' '] + p * 8;
+            else
+                glyph = OLED_F6x8[Text[i] - ' '];
+
+            for (j = 0; j < width && k < max; j++)
+            {
+                buf[k++] = glyph[j];
+            }
         }
+        OLED_WriteArea((Line - 1) + p, Column - 1, buf, k);
     }
 }
 
@@ -470,9 +1096,42 @@ void OLED_ShowChar(uint8_t Line, uint8_t Column, int8_t Char, uint8_t Size)
 void OLED_ShowString(uint8_t Line, uint8_t Column, char *String, uint8_t Size)
 {
     uint8_t i;
-    for (i = 0; String[i] != '\0'; i++)
+    for (i = 0; String[i] != '\0' && i < OLED_COLUMN_NUM; i++)
+        ;
+    OLED_ShowText(Line, Column, String, i, Size);
+}
+
+/**
+ * @brief  将无符号数转换为指定位数的字符（高位补0，超出位数的高位被舍去）。
+ *      从最低位开始一次提取每一位，十六进制、二进制只用移位运算。
+ * @param  Buf 字符缓冲区，长度不小于Length。
+ * @param  Number 要转换的数。
+ * @param  Length 位数。
+ * @param  Radix 进制。
+ *     @arg 取值: 2、10、16
+ * @retval 无
+ */
+static void OLED_FormatUInt(char *Buf, uint32_t Number, uint8_t Length, uint8_t Radix)
+{
+    static const char digits[] = "0123456789ABCDEF";
+
+    while (Length--)
     {
-        OLED_ShowChar(Line, Column + Size * i, String[i], Size);
+        if (Radix == 16)
+        {
+            Buf[Length] = digits[Number & 0x0F];
+            Number >>= 4;
+        }
+        else if (Radix == 2)
+        {
+            Buf[Length] = '0' + (Number & 0x01);
+            Number >>= 1;
+        }
+        else
+        {
+            Buf[Length] = '0' + Number % 10;
+            Number /= 10;
+        }
     }
 }
 
@@ -492,11 +1151,11 @@ void OLED_ShowString(uint8_t Line, uint8_t Column, char *String, uint8_t Size)
  */
 void OLED_ShowNum(uint8_t Line, uint8_t Column, uint32_t Number, uint8_t Length, uint8_t Size)
 {
-    uint8_t i;
-    for (i = 0; i < Length; i++)
-    {
-        OLED_ShowChar(Line, Column + Size * i, Number / OLED_Pow(10, Length - i - 1) % 10 + '0', Size);
-    }
+    char buf[OLED_FMT_MAX];
+    if (Length > OLED_FMT_MAX)
+        Length = OLED_FMT_MAX;
+    OLED_FormatUInt(buf, Number, Length, 10);
+    OLED_ShowText(Line, Column, buf, Length, Size);
 }
 
 /**
@@ -515,18 +1174,12 @@ void OLED_ShowNum(uint8_t Line, uint8_t Column, uint32_t Number, uint8_t Length,
  */
 void OLED_ShowSignedNum(uint8_t Line, uint8_t Column, int32_t Number, uint8_t Length, uint8_t Size)
 {
-    uint32_t Number1;
-    if (Number >= 0)
-    {
-        OLED_ShowChar(Line, Column, '+', Size);
-        Number1 = Number;
-    }
-    else
-    {
-        OLED_ShowChar(Line, Column, '-', Size);
-        Number1 = -Number;
-    }
-    OLED_ShowNum(Line, Column + Size, Number1, Length, Size);
+    char buf[OLED_FMT_MAX];
+    if (Length > OLED_FMT_MAX - 1)
+        Length = OLED_FMT_MAX - 1;
+    buf[0] = (Number >= 0) ? '+' : '-';
+    OLED_FormatUInt(buf + 1, (Number >= 0) ? (uint32_t)Number : -(uint32_t)Number, Length, 10);
+    OLED_ShowText(Line, Column, buf, Length + 1, Size);
 }
 
 /**
@@ -540,27 +1193,110 @@ void OLED_ShowSignedNum(uint8_t Line, uint8_t Column, int32_t Number, uint8_t Le
  * @param  Intlen 要显示的整数位数。
  *     @arg 取值: 1 - 10
  * @param  Declen 要显示的小数位数。
- *     @arg 取值: 1 - 10
+ *     @arg 取值: 0 - 9
  * @param  Size 字符大小。
  *     @arg 取值(宽x高): 6（6x8）、8（8x16）
  * @retval 无
  */
 void OLED_ShowFloat(uint8_t Line, uint8_t Column, float Num, uint8_t Intlen, uint8_t Declen, uint8_t Size)
 {
-    uint8_t p;
-    unsigned long m;
+    static const uint32_t pow10[10] = {1, 10, 100, 1000, 10000, 100000,
+                                       1000000, 10000000, 100000000, 1000000000};
+    char buf[OLED_FMT_MAX];
+    uint32_t integer;
+    uint8_t len;
+    PROF_BEGIN(OLED_ShowFloat);
 
-    OLED_ShowSignedNum(Line, Column, (int32_t)Num, Intlen, Size);
-
-    if (Declen > 0)
-        OLED_ShowChar(Line, Column + Size * (Intlen + 1), '.', Size);
+    if (Intlen > 10)
+        Intlen = 10;
+    if (Declen > 9)
+        Declen = 9;
 
+    buf[0] = (Num < 0) ? '-' : '+';
     if (Num < 0)
         Num = -Num;
-    for (p = 2, m = 10; p <= Declen + 1; p++, m *= 10)
+    integer = (uint32_t)Num;
+    OLED_FormatUInt(buf + 1, integer, Intlen, 10);
+    len = 1 + Intlen;
+
+    if (Declen > 0)
+    {
+        buf[len++] = '.';
+        // 小数部分只做一次浮点乘法，再按整数逐位提取（截断，不四舍五入）
+        OLED_FormatUInt(buf + len, (uint32_t)((Num - integer) * pow10[Declen]), Declen, 10);
+        len += Declen;
+    }
+    OLED_ShowText(Line, Column, buf, len, Size);
+    PROF_END(OLED_ShowFloat);
+}
+
+/**
+ * @brief  OLED显示定点数，可指定总宽度、符号显示方式及小数位数。
+ *      例：Value = -12345，Decimals = 2，Width = 8，Flags = OLED_FMT_DEFAULT -> " -123.45"。
+ * @param  Line 起始行位置。
+ *     @arg 取值: 1 - 8
+ * @param  Column 起始列位置。
+ *     @arg 取值: 1 - 128
+ * @param  Value 定点数值，实际值 = Value / 10^Decimals。
+ * @param  Width 显示的总字符数（含符号和小数点），数字位数不足时按Flags补齐，超出时舍去高位。
+ *     @arg 取值: 1 - 24
+ * @param  Decimals 小数位数。
+ *     @arg 取值: 0 - 9
+ * @param  Flags 格式选项，可按位或组合。
+ *     @arg 有效取值:
+ *      - \b OLED_FMT_DEFAULT : 右对齐，高位补空格，只显示负号
+ *      - \b OLED_FMT_SIGN : 正数也显示'+'号
+ *      - \b OLED_FMT_ZERO : 高位补0（符号位于最左侧）
+ * @param  Size 字符大小。
+ *     @arg 取值(宽x高): 6（6x8）、8（8x16）
+ * @retval 无
+ */
+void OLED_ShowFixed(uint8_t Line, uint8_t Column, int32_t Value, uint8_t Width,
+                    uint8_t Decimals, uint8_t Flags, uint8_t Size)
+{
+    char buf[OLED_FMT_MAX];
+    uint32_t mag = (Value < 0) ? -(uint32_t)Value : (uint32_t)Value;
+    char sign = (Value < 0) ? '-' : ((Flags & OLED_FMT_SIGN) ? '+' : 0);
+    uint8_t i, d;
+
+    if (Width > OLED_FMT_MAX)
+        Width = OLED_FMT_MAX;
+    i = Width;
+
+    // 小数部分及小数点
+    for (d = 0; d < Decimals && i > 0; d++)
+    {
+        buf[--i] = '0' + mag % 10;
+        mag /= 10;
+    }
+    if (Decimals > 0 && i > 0)
+        buf[--i] = '.';
+
+    // 整数部分，至少一位
+    do
+    {
+        if (i == 0)
+            break;
+        buf[--i] = '0' + mag % 10;
+        mag /= 10;
+    } while (mag);
+
+    // 补齐及符号
+    if (Flags & OLED_FMT_ZERO)
+    {
+        while (i > (sign ? 1 : 0))
+            buf[--i] = '0';
+        if (sign && i > 0)
+            buf[--i] = sign;
+    }
+    else
     {
-        OLED_ShowNum(Line, Column + Size * (Intlen + p), (unsigned long)((Num - (uint32_t)Num) * m) % 10, 1, Size);
+        if (sign && i > 0)
+            buf[--i] = sign;
+        while (i > 0)
+            buf[--i] = ' ';
     }
+    OLED_ShowText(Line, Column, buf, Width, Size);
 }
 
 /**
@@ -579,19 +1315,11 @@ void OLED_ShowFloat(uint8_t Line, uint8_t Column, float Num, uint8_t Intlen, uin
  */
 void OLED_ShowHexNum(uint8_t Line, uint8_t Column, uint32_t Number, uint8_t Length, uint8_t Size)
 {
-    uint8_t i, SingleNumber;
-    for (i = 0; i < Length; i++)
-    {
-        SingleNumber = Number / OLED_Pow(16, Length - i - 1) % 16;
-        if (SingleNumber < 10)
-        {
-            OLED_ShowChar(Line, Column + Size * i, SingleNumber + '0', Size);
-        }
-        else
-        {
-            OLED_ShowChar(Line, Column + Size * i, SingleNumber - 10 + 'A', Size);
-        }
-    }
+    char buf[OLED_FMT_MAX];
+    if (Length > OLED_FMT_MAX)
+        Length = OLED_FMT_MAX;
+    OLED_FormatUInt(buf, Number, Length, 16);
+    OLED_ShowText(Line, Column, buf, Length, Size);
 }
 
 /**
@@ -610,11 +1338,11 @@ void OLED_ShowHexNum(uint8_t Line, uint8_t Column, uint32_t Number, uint8_t Leng
  */
 void OLED_ShowBinNum(uint8_t Line, uint8_t Column, uint32_t Number, uint8_t Length, uint8_t Size)
 {
-    uint8_t i;
-    for (i = 0; i < Length; i++)
-    {
-        OLED_ShowChar(Line, Column + Size * i, Number / OLED_Pow(2, Length - i - 1) % 2 + '0', Size);
-    }
+    char buf[OLED_FMT_MAX];
+    if (Length > OLED_FMT_MAX)
+        Length = OLED_FMT_MAX;
+    OLED_FormatUInt(buf, Number, Length, 2);
+    OLED_ShowText(Line, Column, buf, Length, Size);
 }
 
 /**
@@ -628,19 +1356,10 @@ void OLED_ShowBinNum(uint8_t Line, uint8_t Column, uint32_t Number, uint8_t Leng
  */
 void OLED_ShowCN(uint8_t Line, uint8_t Column, uint8_t Num)
 {
-    uint8_t i;
     uint8_t wide = 16; // 字宽
 
-    OLED_SetCursor(Line - 1, Column - 1); // 参数1:把光标设置在第几行. 参数2:把光标设置在第几列
-    for (i = 0; i < wide; i++)
-    {
-        OLED_WriteData(OLED_HzK[Num][i]); // 显示上半部分内容
-    }
-    OLED_SetCursor((Line - 1) + 1, Column - 1);
-    for (i = 0; i < wide; i++)
-    {
-        OLED_WriteData(OLED_HzK[Num][i + wide]); // 显示下半部分内容
-    }
+    OLED_WriteArea(Line - 1, Column - 1, OLED_HzK[Num], wide);               // 显示上半部分内容
+    OLED_WriteArea((Line - 1) + 1, Column - 1, OLED_HzK[Num] + wide, wide); // 显示下半部分内容
 }
 
 /**
@@ -656,7 +1375,7 @@ void OLED_ShowCN(uint8_t Line, uint8_t Column, uint8_t Num)
  * @param  BMP 图片模数组。
  * @retval 无
  */
-void OLED_DrawBMP(uint8_t LineS, uint8_t LineE, uint8_t ColumnS, uint8_t ColumnE, uint8_t BMP[])
+void OLED_DrawBMP(uint8_t LineS, uint8_t LineE, uint8_t ColumnS, uint8_t ColumnE, const uint8_t BMP[])
 {
     uint32_t j = 0;
     uint8_t x, y;
@@ -665,12 +1384,63 @@ void OLED_DrawBMP(uint8_t LineS, uint8_t LineE, uint8_t ColumnS, uint8_t ColumnE
         y = (LineE - 1) / 8;
     else
         y = (LineE - 1) / 8 + 1;
+    x = ColumnE - ColumnS + 1; // 每页的列数
+    for (y = (LineS - 1); y <= (LineE - 1); y++)
+    {
+        OLED_WriteArea(y, (ColumnS - 1), &BMP[j], x);
+        j += x;
+    }
+}
+
+/**
+ * @brief  OLED显示PackBits行程编码压缩的图片，边解码边输出，不需要完整图片大小的缓冲区。
+ *      压缩数据由若干个包组成，每个包以一个包头字节n开始：
+ *      - n = 0 - 127   : 其后n+1个字节原样输出；
+ *      - n = 129 - 255 : 其后1个字节重复输出257-n次（2 - 128次）；
+ *      - n = 128       : 空包，忽略。
+ *      解码后的数据排列方式与OLED_DrawBMP相同（按页从左到右、从上到下）。
+ * @param  LineS 绘制图片的起始行位置。
+ *     @arg 取值: 1 - 8
+ * @param  LineE 绘制图片的终止行位置。
+ *     @arg 取值: 1 - 8
+ * @param  ColumnS 绘制图片的起始列位置。
+ *     @arg 取值: 1 - 128
+ * @param  ColumnE 绘制图片的终止列位置。
+ *     @arg 取值: 1 - 128
+ * @param  RLE 压缩后的图片数据。
+ * @retval 无
+ */
+void OLED_DrawBMP_RLE(uint8_t LineS, uint8_t LineE, uint8_t ColumnS, uint8_t ColumnE, const uint8_t *RLE)
+{
+    uint8_t buf[OLED_COLUMN_NUM]; // 一页的解码结果
+    uint8_t width = ColumnE - ColumnS + 1;
+    uint8_t count = 0;  // 当前包剩余字节数
+    uint8_t repeat = 0; // 当前包是否为重复包
+    uint8_t value = 0;  // 重复包的数据
+    uint8_t header, x, y;
+
     for (y = (LineS - 1); y <= (LineE - 1); y++)
     {
-        OLED_SetCursor(y, (ColumnS - 1));
-        for (x = (ColumnS - 1); x <= (ColumnE - 1); x++)
+        for (x = 0; x < width; x++)
         {
-            OLED_WriteData(BMP[j++]);
+            while (count == 0) // 读取下一个包头，包可以跨页
+            {
+                header = *RLE++;
+                if (header < 128)
+                {
+                    count = header + 1;
+                    repeat = 0;
+                }
+                else if (header > 128)
+                {
+                    count = 257 - header;
+                    repeat = 1;
+                    value = *RLE++;
+                }
+            }
+            buf[x] = repeat ? value : *RLE++;
+            count--;
         }
+        OLED_WriteArea(y, (ColumnS - 1), buf, width);
     }
 }
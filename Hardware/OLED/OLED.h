@@ -17,6 +17,7 @@
 #define __OLED_H
 
 #include "stdint.h"
+#include "pt.h"
 
 
 /* 指定OLED驱动芯片型号 --------------------------------------------------------------*/
@@ -33,6 +34,80 @@
 #endif
 
 
+/* 指定OLED通信方式 --------------------------------------------------------------*/
+/**
+ * @note 两种方式均使用 PB8 -> SCL | PB9 -> SDA，选择一个宏定义即可。
+ *      OLED_I2C_SOFTWARE: 模拟I2C（I2C_Software.c），传输期间CPU一直忙于翻转引脚。
+ *      OLED_I2C_HARDWARE: 硬件I2C1重映射 + DMA1通道6（I2C_Hardware.c），400kHz，
+ *                         启用显存缓冲区时OLED_Flush()启动DMA传输后立即返回，刷新过程不占用CPU。
+ */
+#define OLED_I2C_SOFTWARE
+// #define OLED_I2C_HARDWARE
+
+// 若没有正确指定OLED通信方式则触发编译错误
+#if (defined(OLED_I2C_SOFTWARE) && defined(OLED_I2C_HARDWARE)) || (!defined(OLED_I2C_SOFTWARE) && !defined(OLED_I2C_HARDWARE))
+#error "Need to specify a unique OLED I2C interface! See OLED.h file."
+#endif
+
+
+/* 显存缓冲区配置 --------------------------------------------------------------*/
+/**
+ * @note 启用后在RAM中开辟 128x64/8 = 1KB 的显存缓冲区(OLED_GRAM)。
+ *      所有Show*、DrawBMP、Clear函数只修改显存，并记录每页发生变化的列范围，
+ *      调用OLED_Flush()时仅将变化的部分发送到屏幕，大幅减少I2C总线数据量。
+ *      注释掉该宏则恢复为直接写屏模式（每次显示立即发送到屏幕）。
+ */
+// #define OLED_USE_FRAMEBUFFER
+
+/* I2C总线传输统计 --------------------------------------------------------------*/
+/**
+ * @note 启用后OLED_BusStats会累计发送到屏幕的I2C传输次数（起始-停止为一次）及字节数（含地址和控制字节），
+ *      可用于比较不同刷新方式的总线开销，调试完成后建议关闭。
+ */
+// #define OLED_BUS_STATS
+
+/* 后台异步刷新配置 --------------------------------------------------------------*/
+/**
+ * @note 启用后（需同时启用OLED_USE_FRAMEBUFFER）由TIM4更新中断在后台把显存的变化部分刷新到屏幕，
+ *      主循环中的Show*函数只写显存，无需再调用OLED_Flush()，显示刷新不再占用主循环时间。
+ *      模拟I2C方式：每次中断发送一个"片"：设置光标 + 最多OLED_SLICE_BYTES个显示数据，
+ *                   单片耗时约为 (5 + 2 + OLED_SLICE_BYTES) x 9 / SCL频率，
+ *                   400kHz、16字节时约520us，可通过OLED_RefreshStats.MaxSliceUs查看实测最大值。
+ *      硬件I2C方式：中断只负责在DMA空闲时启动刷新，后续数据由DMA传输完成中断依次发送。
+ *      TIM4中断为最低优先级，控制环应放在更高优先级的中断中运行（需先设置NVIC_PriorityGroup_2，见main.c）。
+ *      单片耗时远大于串口一个字符的时间（115200bps时约87us），串口中断的抢占优先级必须高于TIM4（USART.c中为2），
+ *      否则刷新期间收到的字节会溢出丢失；其他在刷新期间需要及时响应的中断同样不能与TIM4同级。
+ *      注意：启用后不要再直接调用OLED_SetCursor + OLED_WriteData组合写屏（后台刷新会改变光标位置），
+ *            应修改OLED_GRAM并调用OLED_MarkDirty()。
+ */
+// #define OLED_ASYNC_REFRESH
+
+#define OLED_REFRESH_FREQ 1000 // 后台刷新中断频率（Hz）
+#define OLED_SLICE_BYTES 16    // 模拟I2C方式下每次中断最多发送的显示数据字节数
+
+#if defined(OLED_ASYNC_REFRESH) && !defined(OLED_USE_FRAMEBUFFER)
+#error "OLED_ASYNC_REFRESH requires OLED_USE_FRAMEBUFFER! See OLED.h file."
+#endif
+
+/* 时序配置 --------------------------------------------------------------*/
+/**
+ * @note 等待时间以SysTick节拍（delay.h，默认1ms）计。阻塞版本（OLED_Init、OLED_Scroll_*）用Delay_ms()在函数内等待，
+ *      不依赖SysTick中断；协程版本（OLED_Init_PT）及OLED_ScrollSettled()让出CPU等待，等待期间可运行控制环等其他任务。
+ */
+#define OLED_POWERUP_TICKS 100      // 上电后等待屏幕内部电源稳定的时间
+#define OLED_SCROLL_SETTLE_TICKS 50 // 停止滚动后到重新配置滚动的等待时间
+
+/* 数字显示格式选项 --------------------------------------------------------------*/
+#define OLED_FMT_MAX 24 // 数字显示最多字符数（含符号和小数点）
+
+#define OLED_FMT_DEFAULT 0x00 // 右对齐，高位补空格，只显示负号
+#define OLED_FMT_SIGN 0x01    // 正数也显示'+'号
+#define OLED_FMT_ZERO 0x02    // 高位补0
+
+#define OLED_PAGE_NUM 8     // 屏幕页数（每页8像素行）
+#define OLED_COLUMN_NUM 128 // 屏幕列数
+
+
 /* 参数定义 ----------------------------------------------------------------------*/
 // 屏幕测试模式开启/关闭
 typedef enum
@@ -83,9 +158,36 @@ typedef enum
 } OLED_ScrSpeed;
 
 
+#ifdef OLED_BUS_STATS
+// I2C总线传输统计
+typedef struct
+{
+    uint32_t Transactions; // I2C传输次数
+    uint32_t Bytes;        // 发送的总字节数
+} OLED_BusStat;
+
+extern OLED_BusStat OLED_BusStats;
+#endif
+
+#ifdef OLED_ASYNC_REFRESH
+// 后台刷新统计，时间单位为us，从TIM4更新事件开始计时（包含中断响应延迟）
+typedef struct
+{
+    uint16_t MaxSliceUs;  // 单次刷新中断的最长耗时
+    uint16_t LastSliceUs; // 最近一次刷新中断的耗时
+    uint32_t Slices;      // 实际发送了数据的中断次数
+    uint32_t Overruns;    // 耗时超过一个中断周期的次数
+} OLED_RefreshStat;
+
+extern volatile OLED_RefreshStat OLED_RefreshStats;
+#endif
+
+
 /* 函数声明 ----------------------------------------------------------------------*/
-void OLED_WriteCommand(uint8_t Command);           // 向OLED屏发送指令。
-void OLED_WriteData(uint8_t Data);                 // 向OLED屏发送数据。
+void OLED_WriteCommand(uint8_t Command);                        // 向OLED屏发送指令。
+void OLED_WriteData(uint8_t Data);                              // 向OLED屏发送数据。
+void OLED_WriteCommandBurst(const uint8_t *Command, uint8_t Len); // 在一次传输中连续发送多条指令。
+void OLED_WriteDataBurst(const uint8_t *Data, uint16_t Len);     // 在一次传输中连续发送多个数据。
 void OLED_SetCursor(uint8_t Line, uint8_t Column); // 设置屏幕显示起始坐标。
 void OLED_Display_Off(void);                       // 关闭OLED屏幕显示。
 void OLED_Display_On(void);                        // 打开OLED屏幕显示。
@@ -110,8 +212,9 @@ void OLED_Scroll_VH(OLED_ScrVerHorDir ScrVLR, uint8_t LineS, uint8_t LineE,
                     uint8_t Offset, OLED_ScrSpeed Speed); // 设置OLED屏幕连续垂直+水平滚动。
 #endif
 
-void OLED_Stop_Scroll(void);  // 停止OLED屏幕连续水平滚动。
-void OLED_Start_Scroll(void); // 启用OLED屏幕连续水平滚动。
+void OLED_Stop_Scroll(void);        // 停止OLED屏幕连续水平滚动。
+void OLED_Start_Scroll(void);       // 启用OLED屏幕连续水平滚动。
+uint8_t OLED_ScrollSettled(void);   // 查询停止滚动后的等待时间是否已到。
 
 uint32_t OLED_Pow(uint32_t X, uint32_t Y);
 
@@ -130,6 +233,9 @@ void OLED_ShowSignedNum(uint8_t Line, uint8_t Column,
 void OLED_ShowFloat(uint8_t Line, uint8_t Column,
                     float Num, uint8_t Intlen, uint8_t Declen, uint8_t Size); // 在指定位置显示一个浮点数。
 
+void OLED_ShowFixed(uint8_t Line, uint8_t Column, int32_t Value, uint8_t Width,
+                    uint8_t Decimals, uint8_t Flags, uint8_t Size); // 在指定位置显示一个定点数。
+
 void OLED_ShowHexNum(uint8_t Line, uint8_t Column,
                      uint32_t Number, uint8_t Length, uint8_t Size); // 在指定位置显示一个十六进制数。
 
@@ -139,8 +245,131 @@ void OLED_ShowBinNum(uint8_t Line, uint8_t Column,
 void OLED_ShowCN(uint8_t Line, uint8_t Column, uint8_t Num); // 在指定位置显示一个汉字。
 
 void OLED_DrawBMP(uint8_t LineS, uint8_t LineE,
-                  uint8_t ColumnS, uint8_t ColumnE, uint8_t BMP[]); // 在指定位置显示一个BMP图片。
+                  uint8_t ColumnS, uint8_t ColumnE, const uint8_t BMP[]); // 在指定位置显示一个BMP图片。
+
+void OLED_DrawBMP_RLE(uint8_t LineS, uint8_t LineE,
+                      uint8_t ColumnS, uint8_t ColumnE, const uint8_t *RLE); // 在指定位置显示一个行程编码压缩的图片。
 
-void OLED_Init(void); // 初始化OLED屏幕。
+void OLED_Init(void);           // 初始化OLED屏幕。
+uint8_t OLED_Init_PT(PT *pt);   // 初始化OLED屏幕（协程版本，等待上电时不占用CPU）。
+
+#ifdef OLED_USE_FRAMEBUFFER
+extern uint8_t OLED_GRAM[OLED_PAGE_NUM][OLED_COLUMN_NUM]; // OLED显存缓冲区
+
+void OLED_MarkDirty(uint8_t Page, uint8_t ColumnS, uint8_t ColumnE); // 标记显存指定区域需要刷新。
+void OLED_Flush(void);                                               // 将显存中变化的部分刷新到屏幕。
+uint8_t OLED_FlushBusy(void);                                        // 查询显存是否正在刷新到屏幕。
+#endif
 
 #endif /* __OLED_H */
+
+/**
+  ***************************************************
+  * @example 显存缓冲区刷新例程（需在OLED.h中启用OLED_USE_FRAMEBUFFER）
+  * @brief   在显存中更新多行数据，最后一次性刷新到屏幕
+  ***************************************************
+    OLED_Init();
+    OLED_ShowString(1, 1, "Speed:", 8);
+    OLED_ShowString(3, 1, "Angle:", 8);
+
+    while (1)
+    {
+        OLED_ShowNum(1, 57, speed, 4, 8);          // 仅写入显存
+        OLED_ShowFloat(3, 57, angle, 3, 2, 8);     // 仅写入显存
+        OLED_Flush();                              // 只发送内容发生变化的列
+    }
+  ***************************************************
+  */
+
+/**
+  ***************************************************
+  * @example 后台异步刷新例程（需在OLED.h中启用OLED_USE_FRAMEBUFFER和OLED_ASYNC_REFRESH）
+  * @brief   控制环中只写显存，显示刷新在TIM4中断中分片完成，不阻塞控制环
+  ***************************************************
+    OLED_Init(); // 同时启动后台刷新定时器
+    OLED_ShowString(5, 1, "Mnow:", 8);
+    OLED_ShowString(7, 1, "Mpidout:", 8);
+
+    while (1)
+    {
+        Motor_pidout = PID_Compute(&MotorPID, Motor_now);
+        OLED_ShowNum(5, 41, Motor_now, 4, 8);          // 只写显存，约几微秒
+        OLED_ShowFloat(7, 65, Motor_pidout, 3, 2, 8);  // 只写显存
+
+        // 按控制周期预算单片刷新时间
+        if (OLED_RefreshStats.MaxSliceUs > 600)
+        {
+            // 减小OLED_SLICE_BYTES或提高SCL频率
+        }
+    }
+  ***************************************************
+  */
+
+/**
+  ***************************************************
+  * @example I2C总线传输统计例程（需在OLED.h中启用OLED_BUS_STATS）
+  * @brief   统计一次清屏/显示字符产生的I2C传输次数和字节数
+  ***************************************************
+    OLED_BusStats.Transactions = 0;
+    OLED_BusStats.Bytes = 0;
+    OLED_Clear();
+    // 在调试器Watch窗口中查看OLED_BusStats
+
+    OLED_BusStats.Transactions = 0;
+    OLED_BusStats.Bytes = 0;
+    OLED_ShowChar(1, 1, 'A', 8);
+
+    上位机可用Hardware/OLED/Host/oled_bus_stats.c（编译方法见该文件）得到同样的统计，baseline两列为旧驱动逐字节发送时的次数和字节数，输出（直接写屏）：
+    mode: direct
+                                 transactions    bytes  baseline tx    bytes
+    OLED_Init()                            39     1149         1071     3213
+    OLED_Clear() (blank)                   16     1080         1048     3144
+    OLED_ShowChar 8x16                      4       30           22       66
+    OLED_ShowChar 8x16 (same)               4       30           22       66
+    OLED_ShowChar 6x8                       2       13            9       27
+    OLED_ShowString 12 x 8x16               4      206          198      594
+    OLED_ShowNum 10 x 6x8                   2       67           63      189
+    OLED_Clear() (after text)              16     1080         1048     3144
+
+    加 -DOLED_USE_FRAMEBUFFER 编译（统计包含OLED_Flush）：
+    mode: framebuffer (counts include OLED_Flush)
+                                 transactions    bytes  baseline tx    bytes
+    OLED_Init()                            39     1149         1071     3213
+    OLED_Clear() (blank)                    0        0            0        0
+    OLED_ShowChar 8x16                      4       25           17       51
+    OLED_ShowChar 8x16 (same)               0        0            0        0
+    OLED_ShowChar 6x8                       2       12            8       24
+    OLED_ShowString 12 x 8x16               4      198          190      570
+    OLED_ShowNum 10 x 6x8                   2       65           61      183
+    OLED_Clear() (after text)               8      276          260      780
+  ***************************************************
+  */
+
+/**
+  ***************************************************
+  * @example 数字显示耗时测试例程（建议启用OLED_USE_FRAMEBUFFER，只测量格式化和写显存的时间）
+  * @brief   用Delay_Cycles()（delay.h）比较逐位调用OLED_Pow的旧算法与OLED_ShowNum的CPU周期数
+  ***************************************************
+    uint32_t t0, t1, cycles_old, cycles_new;
+    uint32_t Number = 1234567890;
+    uint8_t i, Length = 10;
+
+    // 旧算法：每一位都要OLED_Pow循环 + 除法 + 取余，并单独显示一个字符
+    t0 = Delay_Cycles();
+    for (i = 0; i < Length; i++)
+    {
+        OLED_ShowChar(1, 1 + 8 * i, Number / OLED_Pow(10, Length - i - 1) % 10 + '0', 8);
+    }
+    t1 = Delay_Cycles();
+    cycles_old = t1 - t0;
+
+    // 新算法：一次提取全部数字，每页拼接字模后写入一次
+    t0 = Delay_Cycles();
+    OLED_ShowNum(3, 1, Number, Length, 8);
+    t1 = Delay_Cycles();
+    cycles_new = t1 - t0;
+
+    // 定点数：-123.45，总宽度8，显示为" -123.45"
+    OLED_ShowFixed(5, 1, -12345, 8, 2, OLED_FMT_DEFAULT, 8);
+  ***************************************************
+  */
@@ -1,7 +1,11 @@
 #ifndef __OLED_BMP_H
 #define __OLED_BMP_H
 
-unsigned char BMP[][1024] =
+/**
+ * 图片模数组，每幅图片128x64像素，按页（8像素行）从左到右、从上到下排列，共1024字节。
+ * 声明为const，编译器将其放在Flash中，不占用RAM，也不会在启动时被复制。
+ */
+const unsigned char BMP[][1024] =
 {
     0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
     0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
@@ -69,4 +73,28 @@ unsigned char BMP[][1024] =
     0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
 };
 
+/**
+ * 与BMP[0]相同的图片，使用PackBits行程编码压缩（1024字节 -> 249字节），用OLED_DrawBMP_RLE显示。
+ * 编码格式见OLED_DrawBMP_RLE函数说明，可用任意PackBits编码工具由原始图片模数组生成。
+ */
+const unsigned char BMP_RLE[] =
+{
+    0x81,0x00,0xCD,0x00,0x05,0xC0,0xE0,0xF0,0x70,0x38,0x18,0xFF,0x1C,0xFD,0x0C,0x01,
+    0x1C,0x9C,0xFF,0xF8,0x00,0xF0,0xFB,0xE0,0xFE,0xC0,0x00,0x80,0xA5,0x00,0x04,0x80,
+    0xE0,0xF0,0x78,0x38,0xFF,0x1C,0x00,0xFE,0xFF,0xFF,0x00,0x03,0xFE,0x00,0x02,0xF0,
+    0xF8,0x38,0xFF,0x1C,0xFF,0x0E,0x00,0x07,0xFF,0x83,0x01,0xC1,0xE1,0xFF,0x60,0xFF,
+    0xE0,0xFF,0xC0,0x00,0x80,0xFF,0x01,0x05,0x03,0x07,0x1E,0xFC,0xF8,0x80,0xAB,0x00,
+    0x00,0xFE,0xFF,0xFF,0x00,0x01,0xFD,0x00,0xFE,0xFF,0xFD,0x00,0xFF,0xFF,0x00,0x1C,
+    0xFF,0x0C,0x00,0x06,0xFE,0x07,0x04,0x0D,0x0C,0x18,0xF8,0xF0,0xFF,0x60,0x04,0xC1,
+    0xC3,0x83,0x87,0x07,0xFF,0x0E,0x04,0x1E,0x3F,0xFF,0xF3,0xC0,0xAB,0x00,0x04,0x03,
+    0xCF,0xFF,0xFC,0x38,0xFF,0x70,0x04,0xE0,0xE1,0xC1,0xC3,0x83,0xFF,0x06,0x04,0x0F,
+    0x1F,0x18,0x30,0xB0,0xFE,0xE0,0x00,0x60,0xFF,0x30,0x00,0x38,0xFF,0xFF,0xFD,0x00,
+    0xFE,0xFF,0xFD,0x00,0x00,0x80,0xFF,0xFF,0x00,0x7F,0xAB,0x00,0x05,0x01,0x1F,0x3F,
+    0x78,0xE0,0xC0,0xFF,0x80,0x00,0x01,0xFF,0x03,0xFF,0x07,0xFF,0x06,0xFF,0x83,0xFF,
+    0xC1,0x00,0xE0,0xFF,0x70,0xFF,0x38,0x02,0x1C,0x1F,0x0F,0xFE,0x00,0x00,0xE0,0xFF,
+    0xFF,0x00,0x7F,0xFF,0x38,0x04,0x1C,0x1E,0x0F,0x07,0x01,0xA5,0x00,0x00,0x01,0xFE,
+    0x03,0xFB,0x07,0x00,0x0F,0xFF,0x1F,0x01,0x39,0x38,0xFD,0x30,0xFF,0x38,0x05,0x18,
+    0x1C,0x0E,0x0F,0x07,0x03,0x81,0x00,0xCD,0x00,
+};
+
 #endif /* __OLED_BMP_H */
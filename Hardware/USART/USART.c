@@ -1,9 +1,10 @@
 #include "USART.h"
+#include "format.h"
+#include "profile.h"
 
 /**
  * 串口接收状态标志。
- * bit15，接收到0x0a置1，接收完成；
- * bit14，接收到0x0d置1；
+ * bit15，已取出一行数据到USART_RX_BUF，接收完成；
  * bit13~bit0，接收到的有效字节数。
  */
 uint16_t USART_RX_STA = 0;
@@ -15,6 +16,44 @@ uint16_t USART_RX_STA = 0;
  */
 uint8_t USART_RX_BUF[USART_REC_LEN];
 
+/**
+ * 接收环形缓冲区（单生产者：接收中断，单消费者：主程序），无需关中断。
+ * USART_RxHead只由中断写入，USART_RxTail只由主程序写入，两者为自由递增的计数值，
+ * 用 (计数值 & (USART_RX_RING_SIZE - 1)) 得到数组下标，二者之差即为缓冲区中的字节数。
+ */
+static uint8_t USART_RxRing[USART_RX_RING_SIZE];
+static volatile uint16_t USART_RxHead;
+static volatile uint16_t USART_RxTail;
+
+/**
+ * 帧边界队列（单生产者：空闲中断，单消费者：主程序）。
+ * 每个元素为总线空闲时USART_RxHead的值，即一帧数据结束的位置。
+ */
+static volatile uint16_t USART_FrameEnd[USART_RX_FRAME_NUM];
+static volatile uint8_t USART_FrameHead;
+static volatile uint8_t USART_FrameTail;
+static uint16_t USART_FrameLast; // 上一个帧边界，仅中断中使用
+
+static void (*USART_RxCallback)(void) = 0; // 收到一帧数据后在中断中调用
+
+#ifdef USART_RX_DMA
+static uint16_t USART_DmaLast; // 上次更新时DMA在环形缓冲区中的写入位置，仅中断中使用
+#endif
+
+volatile UART_RxStat UART_RxStats; // 接收统计
+
+/**
+ * 发送队列（单生产者：主程序，单消费者：DMA1通道4）。
+ * [USART_TxTail - USART_TxBusy, USART_TxTail) 为DMA正在发送的数据，[USART_TxTail, USART_TxHead) 为等待发送的数据。
+ * USART_TxHead只由主程序写入；USART_TxTail和USART_TxBusy在DMA中断中或关中断时写入。
+ */
+static uint8_t USART_TxRing[USART_TX_RING_SIZE];
+static volatile uint16_t USART_TxHead;
+static volatile uint16_t USART_TxTail;
+static volatile uint16_t USART_TxBusy; // DMA正在发送的字节数，0表示空闲
+
+volatile UART_TxStat UART_TxStats; // 发送统计
+
 /**
  * @brief  初始化串口，PA9-TXD | PA10-RXD。
  * @param  bound 串口波特率。
@@ -25,6 +64,7 @@ void UART_init(uint32_t bound)
     GPIO_InitTypeDef GPIO_InitStructure;
     USART_InitTypeDef USART_InitStructure;
     NVIC_InitTypeDef NVIC_InitStructure;
+    DMA_InitTypeDef DMA_InitStructure;
 
     RCC_APB2PeriphClockCmd(RCC_APB2Periph_USART1 | RCC_APB2Periph_GPIOA, ENABLE); // 使能USART1，GPIOA时钟
 
@@ -40,11 +80,57 @@ void UART_init(uint32_t bound)
     GPIO_Init(GPIOA, &GPIO_InitStructure);
 
     NVIC_InitStructure.NVIC_IRQChannel = USART1_IRQn;
-    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 3; // 抢占优先级3
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 2; // 抢占优先级2，高于OLED后台刷新（TIM4，单片可达数百us），接收不会溢出
     NVIC_InitStructure.NVIC_IRQChannelSubPriority = 3;        // 响应优先级3
     NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
     NVIC_Init(&NVIC_InitStructure);
 
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+
+    // DMA1通道4：发送队列 -> USART1_DR，每次传输前设置地址和长度
+    DMA_DeInit(DMA1_Channel4);
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&USART1->DR;
+    DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)USART_TxRing;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralDST;
+    DMA_InitStructure.DMA_BufferSize = 1;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_Medium;
+    DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+    DMA_Init(DMA1_Channel4, &DMA_InitStructure);
+    DMA_ITConfig(DMA1_Channel4, DMA_IT_TC, ENABLE);
+    USART_TxHead = USART_TxTail = USART_TxBusy = 0;
+
+    NVIC_InitStructure.NVIC_IRQChannel = DMA1_Channel4_IRQn;
+    NVIC_Init(&NVIC_InitStructure);
+
+#ifdef USART_RX_DMA
+    // DMA1通道5：USART1_DR -> 接收环形缓冲区，循环模式
+    DMA_DeInit(DMA1_Channel5);
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&USART1->DR;
+    DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)USART_RxRing;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralSRC;
+    DMA_InitStructure.DMA_BufferSize = USART_RX_RING_SIZE;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Circular;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+    DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+    DMA_Init(DMA1_Channel5, &DMA_InitStructure);
+    DMA_ITConfig(DMA1_Channel5, DMA_IT_HT | DMA_IT_TC, ENABLE);
+    DMA_Cmd(DMA1_Channel5, ENABLE);
+    USART_DmaLast = 0;
+
+    // 与USART1中断优先级相同，两者不会互相打断，接收位置只在一处被更新
+    NVIC_InitStructure.NVIC_IRQChannel = DMA1_Channel5_IRQn;
+    NVIC_Init(&NVIC_InitStructure);
+#endif
+
     USART_InitStructure.USART_BaudRate = bound;                                     // 串口波特率
     USART_InitStructure.USART_WordLength = USART_WordLength_8b;                     // 8位数据位
     USART_InitStructure.USART_StopBits = USART_StopBits_1;                          // 一个停止位
@@ -53,23 +139,358 @@ void UART_init(uint32_t bound)
     USART_InitStructure.USART_Mode = USART_Mode_Rx | USART_Mode_Tx;                 // 收发模式
 
     USART_Init(USART1, &USART_InitStructure);      // 初始化串口1
+#ifdef USART_RX_DMA
+    USART_DMACmd(USART1, USART_DMAReq_Rx | USART_DMAReq_Tx, ENABLE); // 收发数据均由DMA搬运
+#else
+    USART_DMACmd(USART1, USART_DMAReq_Tx, ENABLE); // 发送数据由DMA搬运
     USART_ITConfig(USART1, USART_IT_RXNE, ENABLE); // 开启串口接受中断
+#endif
+    USART_ITConfig(USART1, USART_IT_IDLE, ENABLE); // 开启总线空闲中断，用于划分帧
     USART_Cmd(USART1, ENABLE);                     // 使能串口1
 }
 
 /**
- * @brief  串口发送数据。
+ * @brief  若DMA空闲且队列中有等待发送的数据，启动一次DMA传输（在DMA中断中或关中断时调用）。
+ *      每次只发送到队列数组末尾为止，回绕部分在下一次传输中发送。
+ * @param  无
+ * @retval 无
+ */
+static void UART_TxStart(void)
+{
+    uint16_t tail = USART_TxTail;
+    uint16_t n = USART_TxHead - tail;
+    uint16_t idx = tail & (USART_TX_RING_SIZE - 1);
+
+    if (USART_TxBusy != 0 || n == 0)
+        return;
+    if (n > USART_TX_RING_SIZE - idx)
+        n = USART_TX_RING_SIZE - idx;
+
+    DMA1_Channel4->CMAR = (uint32_t)&USART_TxRing[idx];
+    DMA1_Channel4->CNDTR = n;
+    USART_TxBusy = n;
+    USART_TxTail = tail + n;
+    UART_TxStats.Chunks++;
+    DMA1_Channel4->CCR |= DMA_CCR1_EN;
+}
+
+/**
+ * @brief  将数据放入发送队列，由DMA在后台发送，函数不等待发送完成。
+ *      队列已满时按USART_TX_POLICY处理。只能由主程序一处调用（单生产者）。
+ * @param  Data 要发送的数据。
+ * @param  Len 数据长度。
+ * @retval 实际放入队列的字节数（USART_TX_BLOCK方式下总是等于Len）。
+ */
+uint16_t UART_Write(const uint8_t *Data, uint16_t Len)
+{
+    uint16_t head = USART_TxHead;
+    uint16_t done = 0;
+    uint16_t space, n, level;
+    uint32_t primask;
+
+    while (done < Len)
+    {
+        space = USART_TX_RING_SIZE - (uint16_t)(head - (USART_TxTail - USART_TxBusy));
+
+#if USART_TX_POLICY == USART_TX_DROP_OLDEST
+        if (space < Len - done)
+        {
+            // 丢弃尚未开始发送的最早数据，正在发送的数据不能丢弃
+            primask = __get_PRIMASK();
+            __disable_irq();
+            n = head - USART_TxTail;
+            if (n > Len - done - space)
+                n = Len - done - space;
+            USART_TxTail += n;
+            UART_TxStats.Dropped += n;
+            __set_PRIMASK(primask);
+            space += n;
+        }
+#endif
+        if (space == 0)
+        {
+#if USART_TX_POLICY == USART_TX_DROP_NEWEST
+            UART_TxStats.Dropped += Len - done;
+            break;
+#else
+            continue; // 等待DMA腾出空间
+#endif
+        }
+
+        n = Len - done;
+        if (n > space)
+            n = space;
+        for (; n > 0; n--)
+            USART_TxRing[head++ & (USART_TX_RING_SIZE - 1)] = Data[done++];
+
+        USART_TxHead = head;
+        level = head - (USART_TxTail - USART_TxBusy);
+        if (level > UART_TxStats.HighWater)
+            UART_TxStats.HighWater = level;
+
+        primask = __get_PRIMASK();
+        __disable_irq();
+        UART_TxStart();
+        __set_PRIMASK(primask);
+    }
+    return done;
+}
+
+/**
+ * @brief  串口发送数据（放入发送队列后立即返回）。
  * @param  data 要发送的数据。
  * @retval 无
  */
 void UART_SendData(uint16_t data)
 {
-    USART_SendData(USART1, data);
-    while (USART_GetFlagStatus(USART1, USART_FLAG_TC) != SET); // 等待发送完成
+    uint8_t c = (uint8_t)data;
+    UART_Write(&c, 1);
+}
+
+// UART_printf()的输出缓冲，攒满一段后一次放入发送队列
+typedef struct
+{
+    uint8_t Buf[32];
+    uint16_t Len;
+} UART_PrintState;
+
+/**
+ * @brief  UART_printf()输出一个字符。
+ * @param  c 要输出的字符。
+ * @param  Arg 指向UART_PrintState。
+ * @retval 无
+ */
+static void UART_PrintPut(char c, void *Arg)
+{
+    UART_PrintState *st = (UART_PrintState *)Arg;
+
+    st->Buf[st->Len++] = (uint8_t)c;
+    if (st->Len == sizeof(st->Buf))
+    {
+        UART_Write(st->Buf, st->Len);
+        st->Len = 0;
+    }
+}
+
+/**
+ * @brief  格式化输出到串口（经发送队列由DMA发送），支持的格式见format.h。
+ * @param  Fmt 格式字符串。
+ * @retval 输出的字符数。
+ */
+int UART_printf(const char *Fmt, ...)
+{
+    UART_PrintState st;
+    va_list ap;
+    int n;
+
+    st.Len = 0;
+    va_start(ap, Fmt);
+    n = Format_vprintf(UART_PrintPut, &st, Fmt, ap);
+    va_end(ap);
+    if (st.Len)
+        UART_Write(st.Buf, st.Len);
+    return n;
 }
 
 /**
- * @brief  判断串口接收是否完成（接收到0x0D 0x0A）。
+ * @brief  查询发送队列中是否还有未发送完的数据。
+ * @param  无
+ * @retval 状态值
+ *      - \b 1 : 正在发送
+ *      - \b 0 : 全部发送完成
+ */
+uint8_t UART_TxBusy(void)
+{
+    return (USART_TxBusy != 0 || USART_TxHead != USART_TxTail ||
+            USART_GetFlagStatus(USART1, USART_FLAG_TC) != SET);
+}
+
+/**
+ * @brief  查询发送队列的剩余空间。只能由主程序调用（与UART_Write()相同的执行环境），
+ *      返回值之内的数据可以由UART_Write()一次完整放入队列，不会阻塞或丢弃。
+ * @param  无
+ * @retval 剩余空间（字节）
+ */
+uint16_t UART_TxFree(void)
+{
+    return USART_TX_RING_SIZE - (uint16_t)(USART_TxHead - (USART_TxTail - USART_TxBusy));
+}
+
+/**
+ * @brief  等待发送队列中的数据全部发送完成（包括最后一个字节移出移位寄存器）。
+ * @param  无
+ * @retval 无
+ */
+void UART_Flush(void)
+{
+    while (UART_TxBusy())
+        ;
+}
+
+void DMA1_Channel4_IRQHandler(void)
+{
+    if (DMA1->ISR & DMA1_IT_TC4)
+    {
+        DMA1->IFCR = DMA1_IT_TC4;
+        DMA1_Channel4->CCR &= ~DMA_CCR1_EN;
+        USART_TxBusy = 0;
+        UART_TxStart(); // 连续发送队列中的下一段数据
+    }
+}
+
+#ifdef USART_RX_DMA
+/**
+ * @brief  DMA模式下检查未读数据是否已被新数据覆盖，若是则跳过被覆盖的部分。
+ * @param  无
+ * @retval 当前的USART_RxTail
+ */
+static uint16_t UART_RxCheckOverwrite(void)
+{
+    uint16_t level = USART_RxHead - USART_RxTail;
+
+    if (level > USART_RX_RING_SIZE)
+    {
+        UART_RxStats.Dropped += level - USART_RX_RING_SIZE;
+        USART_RxTail = USART_RxHead - USART_RX_RING_SIZE;
+    }
+    return USART_RxTail;
+}
+#define UART_RX_TAIL() UART_RxCheckOverwrite()
+#else
+#define UART_RX_TAIL() USART_RxTail
+#endif
+
+/**
+ * @brief  移出帧边界队列中结束位置已被读过的帧边界（主程序中调用）。
+ * @param  Tail 当前的USART_RxTail。
+ * @retval 无
+ */
+static void UART_FrameSkip(uint16_t Tail)
+{
+    uint8_t ft = USART_FrameTail;
+
+    while (ft != USART_FrameHead &&
+           (int16_t)(USART_FrameEnd[ft & (USART_RX_FRAME_NUM - 1)] - Tail) <= 0)
+        ft++;
+    USART_FrameTail = ft;
+}
+
+/**
+ * @brief  获取接收缓冲区中尚未读取的字节数。
+ * @param  无
+ * @retval 字节数
+ */
+uint16_t UART_Available(void)
+{
+    uint16_t tail = UART_RX_TAIL();
+    return (uint16_t)(USART_RxHead - tail);
+}
+
+/**
+ * @brief  从接收缓冲区读取一个字节。
+ * @param  Data 读取到的数据。
+ * @retval 状态值
+ *      - \b 1 : 读取成功
+ *      - \b 0 : 缓冲区为空
+ */
+uint8_t UART_ReadByte(uint8_t *Data)
+{
+    uint16_t tail = UART_RX_TAIL();
+    if (tail == USART_RxHead)
+        return 0;
+    *Data = USART_RxRing[tail & (USART_RX_RING_SIZE - 1)];
+    USART_RxTail = tail + 1;
+    return 1;
+}
+
+/**
+ * @brief  从接收缓冲区取出一行数据（以0x0A结尾，0x0A前的0x0D一并去掉）。
+ *      没有完整的一行时不取出任何数据，可在主循环中反复调用；缓冲区中可同时存放多行。
+ *      若一行超过Size - 1个字节，多余部分被丢弃并计入UART_RxStats.LineOverflows；
+ *      若缓冲区已满仍没有行结束符，则清空缓冲区，避免永远无法取出数据。
+ * @param  Buf 存放一行数据的数组，数据以'\0'结尾。
+ * @param  Size Buf的大小。
+ * @retval 取出的一行数据的长度（不含行结束符）；没有完整的一行时返回 -1。
+ */
+int16_t UART_ReadLine(uint8_t *Buf, uint16_t Size)
+{
+    uint16_t tail = UART_RX_TAIL();
+    uint16_t head = USART_RxHead;
+    uint16_t i, len;
+    uint8_t c;
+
+    // 查找行结束符
+    for (i = tail; i != head; i++)
+    {
+        if (USART_RxRing[i & (USART_RX_RING_SIZE - 1)] == 0x0A)
+            break;
+    }
+    if (i == head)
+    {
+        if ((uint16_t)(head - tail) >= USART_RX_RING_SIZE) // 缓冲区已满且没有行结束符
+        {
+            USART_RxTail = head;
+            UART_RxStats.LineOverflows++;
+        }
+        return -1;
+    }
+
+    // 复制一行数据
+    len = 0;
+    for (; tail != i; tail++)
+    {
+        c = USART_RxRing[tail & (USART_RX_RING_SIZE - 1)];
+        if (len < Size - 1)
+            Buf[len++] = c;
+        else if (c != 0x0D)
+            UART_RxStats.LineOverflows++;
+    }
+    if (len > 0 && Buf[len - 1] == 0x0D)
+        len--;
+    Buf[len] = '\0';
+    USART_RxTail = i + 1; // 连同0x0A一起移出缓冲区
+    UART_FrameSkip(i + 1);
+    UART_RxStats.Lines++;
+    return (int16_t)len;
+}
+
+/**
+ * @brief  从接收缓冲区取出一帧数据。帧以总线空闲（约1个字节时间没有新数据）划分，不要求行结束符。
+ *      已被UART_ReadLine()等函数读走的帧自动跳过。
+ *      若一帧超过Size个字节，多余部分被丢弃并计入UART_RxStats.LineOverflows。
+ * @param  Buf 存放一帧数据的数组（不添加'\0'）。
+ * @param  Size Buf的大小。
+ * @retval 取出的一帧数据的长度；没有完整的一帧时返回 -1。
+ */
+int16_t UART_ReadFrame(uint8_t *Buf, uint16_t Size)
+{
+    uint16_t tail = UART_RX_TAIL();
+    uint16_t end, len, i;
+    uint8_t ft;
+
+    UART_FrameSkip(tail);
+    ft = USART_FrameTail;
+    if (ft == USART_FrameHead)
+        return -1;
+
+    end = USART_FrameEnd[ft & (USART_RX_FRAME_NUM - 1)];
+    len = end - tail;
+    if (len > Size)
+    {
+        UART_RxStats.LineOverflows += len - Size;
+        len = Size;
+    }
+    for (i = 0; i < len; i++)
+        Buf[i] = USART_RxRing[(uint16_t)(tail + i) & (USART_RX_RING_SIZE - 1)];
+
+    USART_RxTail = end;
+    USART_FrameTail = ft + 1;
+    return (int16_t)len;
+}
+
+/**
+ * @brief  判断串口接收是否完成（接收到一行以0x0D 0x0A或0x0A结尾的数据）。
+ *      兼容旧接口：有完整的一行时将其取出到USART_RX_BUF中，直到调用Reset_UART_RecStatus()前不再取下一行。
  * @param  无
  * @retval 状态值
  *      - \b 1 : 接收完成
@@ -77,8 +498,17 @@ void UART_SendData(uint16_t data)
  */
 uint8_t get_UART_RecStatus(void)
 {
-    // 若USART_RX_STA最高位为1，接收完成
-    return ((USART_RX_STA & 0x8000) ? 1 : 0);
+    int16_t len;
+
+    // 若USART_RX_STA最高位为1，上一行数据尚未处理完
+    if (USART_RX_STA & 0x8000)
+        return 1;
+
+    len = UART_ReadLine(USART_RX_BUF, USART_REC_LEN);
+    if (len < 0)
+        return 0;
+    USART_RX_STA = 0x8000 | (uint16_t)len;
+    return 1;
 }
 
 /**
@@ -101,34 +531,130 @@ void Reset_UART_RecStatus(void)
     USART_RX_STA = 0;
 }
 
+/**
+ * @brief  在总线空闲时记录一个帧边界（中断中调用）。
+ * @param  无
+ * @retval 无
+ */
+static void UART_RxMarkFrame(void)
+{
+    uint16_t head = USART_RxHead;
+    uint8_t fh = USART_FrameHead;
+
+    if (head == USART_FrameLast) // 上次空闲后没有收到新数据
+        return;
+    if ((uint8_t)(fh - USART_FrameTail) >= USART_RX_FRAME_NUM)
+    {
+        UART_RxStats.FrameDropped++; // 不更新USART_FrameLast，本帧与下一帧合并
+    }
+    else
+    {
+        USART_FrameEnd[fh & (USART_RX_FRAME_NUM - 1)] = head;
+        USART_FrameHead = fh + 1;
+        USART_FrameLast = head;
+        UART_RxStats.Frames++;
+    }
+
+    if (USART_RxCallback)
+        USART_RxCallback();
+}
+
+/**
+ * @brief  设置接收回调函数，每次总线空闲且收到了新数据时在串口中断中调用，
+ *      可在其中投递事件（如Sched_Post()），由主程序读取数据，无需轮询。
+ * @param  Func 回调函数，为0时取消回调。回调函数在中断中运行，应尽快返回。
+ * @retval 无
+ */
+void UART_SetRxCallback(void (*Func)(void))
+{
+    USART_RxCallback = Func;
+}
+
+#ifdef USART_RX_DMA
+/**
+ * @brief  根据DMA剩余传输数更新USART_RxHead，发布DMA已写入环形缓冲区的数据（中断中调用）。
+ *      HT/TC中断保证两次更新之间写入的数据不超过半个缓冲区。
+ * @param  无
+ * @retval 无
+ */
+static void UART_RxDmaPublish(void)
+{
+    uint16_t pos = USART_RX_RING_SIZE - DMA1_Channel5->CNDTR;
+    uint16_t level;
+
+    USART_RxHead += (uint16_t)(pos - USART_DmaLast) & (USART_RX_RING_SIZE - 1);
+    USART_DmaLast = pos;
+
+    level = USART_RxHead - USART_RxTail;
+    if (level > USART_RX_RING_SIZE)
+        level = USART_RX_RING_SIZE;
+    if (level > UART_RxStats.HighWater)
+        UART_RxStats.HighWater = level;
+}
+
+void DMA1_Channel5_IRQHandler(void)
+{
+    uint32_t isr = DMA1->ISR;
+
+    if (isr & (DMA1_IT_HT5 | DMA1_IT_TC5))
+    {
+        DMA1->IFCR = DMA1_IT_HT5 | DMA1_IT_TC5;
+        UART_RxDmaPublish();
+    }
+}
+
 void USART1_IRQHandler(void)
 {
+    PROF_BEGIN(USART1_IRQ);
+    uint16_t sr = USART1->SR;
+
+    if (sr & USART_SR_IDLE)
+    {
+        (void)USART1->DR; // 先读SR再读DR，清除IDLE（同时清除ORE）；空闲时DR中没有未搬运的数据
+
+        if (sr & USART_SR_ORE) // DMA未及时搬运，串口丢失数据
+            UART_RxStats.Overruns++;
+
+        UART_RxDmaPublish();
+        UART_RxMarkFrame();
+    }
+    PROF_END(USART1_IRQ);
+}
+#else
+void USART1_IRQHandler(void)
+{
+    PROF_BEGIN(USART1_IRQ);
     uint8_t Res;
-    if (USART_GetITStatus(USART1, USART_IT_RXNE) != RESET) // 接收中断(接收到的数据必须是0x0d 0x0a结尾)
+    uint16_t level;
+    uint16_t sr = USART1->SR;
+
+    if (sr & (USART_SR_RXNE | USART_SR_ORE)) // 接收中断（溢出错误也由RXNEIE触发）
     {
-        Res = USART_ReceiveData(USART1); // 读取接收到的数据
+        Res = USART1->DR; // 先读SR再读DR，同时清除RXNE和ORE标志
+
+        if (sr & USART_SR_ORE) // 上一个字节未及时读取，已丢失
+            UART_RxStats.Overruns++;
 
-        if ((USART_RX_STA & 0x8000) == 0) // 接收未完成
+        level = USART_RxHead - USART_RxTail;
+        if (level >= USART_RX_RING_SIZE) // 环形缓冲区已满，丢弃新数据
         {
-            if (USART_RX_STA & 0x4000) // 接收到了0x0d
-            {
-                if (Res != 0x0a)
-                    USART_RX_STA = 0; // 接收错误,重新开始
-                else
-                    USART_RX_STA |= 0x8000; // 接收完成
-            }
-            else // 还没收到0X0d
-            {
-                if (Res == 0x0d)
-                    USART_RX_STA |= 0x4000;
-                else
-                {
-                    USART_RX_BUF[USART_RX_STA & 0X3FFF] = Res;
-                    USART_RX_STA++;
-                    if (USART_RX_STA > (USART_REC_LEN - 1))
-                        USART_RX_STA = 0; // 接收数据错误,重新开始接收
-                }
-            }
+            UART_RxStats.Dropped++;
+        }
+        else
+        {
+            USART_RxRing[USART_RxHead & (USART_RX_RING_SIZE - 1)] = Res;
+            USART_RxHead++;
+            if (level + 1 > UART_RxStats.HighWater)
+                UART_RxStats.HighWater = level + 1;
         }
     }
+    else if (sr & USART_SR_IDLE)
+    {
+        (void)USART1->DR; // 先读SR再读DR，清除IDLE标志
+    }
+
+    if (sr & USART_SR_IDLE) // 读取DR时IDLE已一并清除
+        UART_RxMarkFrame();
+    PROF_END(USART1_IRQ);
 }
+#endif
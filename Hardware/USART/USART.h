@@ -4,10 +4,93 @@
 
 #define USART_REC_LEN 200 // 定义最大接收字节数 200
 
+/**
+ * 接收环形缓冲区大小，必须是2的整数次幂（最大32768）。
+ * 可根据UART_RxStats.HighWater（历史最高占用）和Dropped（缓冲区满丢弃的字节数）调整。
+ */
+#define USART_RX_RING_SIZE 256
+
+#if (USART_RX_RING_SIZE & (USART_RX_RING_SIZE - 1)) != 0 || USART_RX_RING_SIZE > 32768
+#error "USART_RX_RING_SIZE must be a power of two not greater than 32768! See USART.h file."
+#endif
+
+/**
+ * 接收方式选择。
+ * 默认每接收一个字节进入一次中断；定义USART_RX_DMA后由DMA1通道5以循环模式将数据直接写入环形缓冲区，
+ * 只在总线空闲（IDLE）、DMA半满（HT）和全满（TC）时进入中断更新接收位置，每帧数据只需几次中断，适合921600等高波特率。
+ * DMA模式下数据不经过CPU，主程序读取不及时时新数据会覆盖旧数据，被覆盖的字节在读取时计入UART_RxStats.Dropped。
+ */
+// #define USART_RX_DMA
+
+/**
+ * 帧边界队列长度，必须是2的整数次幂（最大128）。
+ * 每次总线空闲记录一个帧边界，供UART_ReadFrame()按帧取出数据；队列满时新的边界被丢弃，相邻两帧合并为一帧。
+ */
+#define USART_RX_FRAME_NUM 8
+
+#if (USART_RX_FRAME_NUM & (USART_RX_FRAME_NUM - 1)) != 0 || USART_RX_FRAME_NUM > 128
+#error "USART_RX_FRAME_NUM must be a power of two not greater than 128! See USART.h file."
+#endif
+
+/**
+ * 发送队列大小，必须是2的整数次幂（最大32768）。
+ * UART_SendData()/UART_Write()只把数据放入发送队列即返回，由DMA1通道4在后台发送。
+ */
+#define USART_TX_RING_SIZE 256
+
+#if (USART_TX_RING_SIZE & (USART_TX_RING_SIZE - 1)) != 0 || USART_TX_RING_SIZE > 32768
+#error "USART_TX_RING_SIZE must be a power of two not greater than 32768! See USART.h file."
+#endif
+
+/**
+ * 发送队列已满时的处理方式。
+ */
+#define USART_TX_BLOCK 0       // 等待队列腾出空间（数据不丢失，不能在关中断或优先级不低于DMA1通道4的中断中调用）
+#define USART_TX_DROP_OLDEST 1 // 丢弃队列中最早的、尚未开始发送的数据
+#define USART_TX_DROP_NEWEST 2 // 丢弃放不下的新数据
+
+#define USART_TX_POLICY USART_TX_BLOCK
+
+#if USART_TX_POLICY != USART_TX_BLOCK && USART_TX_POLICY != USART_TX_DROP_OLDEST && USART_TX_POLICY != USART_TX_DROP_NEWEST
+#error "USART_TX_POLICY must be USART_TX_BLOCK, USART_TX_DROP_OLDEST or USART_TX_DROP_NEWEST! See USART.h file."
+#endif
+
+// 接收统计
+typedef struct
+{
+    uint32_t Overruns;      // 硬件溢出次数（中断未及时读取，串口丢失数据）
+    uint32_t Dropped;       // 环形缓冲区已满而丢弃的字节数
+    uint32_t Lines;         // 已取出的行数
+    uint32_t LineOverflows; // 超出行缓冲区长度而丢弃的字节数
+    uint32_t Frames;        // 总线空闲产生的帧数
+    uint32_t FrameDropped;  // 帧边界队列已满而丢弃的帧边界数
+    uint16_t HighWater;     // 环形缓冲区历史最高占用字节数
+} UART_RxStat;
+
+// 发送统计
+typedef struct
+{
+    uint32_t Chunks;    // DMA传输次数
+    uint32_t Dropped;   // 队列已满而丢弃的字节数
+    uint16_t HighWater; // 发送队列历史最高占用字节数
+} UART_TxStat;
+
 extern uint8_t USART_RX_BUF[USART_REC_LEN];
+extern volatile UART_RxStat UART_RxStats;
+extern volatile UART_TxStat UART_TxStats;
 
 void UART_init(uint32_t bound);
 void UART_SendData(uint16_t data);
+uint16_t UART_Write(const uint8_t *Data, uint16_t Len);
+int UART_printf(const char *Fmt, ...);
+uint8_t UART_TxBusy(void);
+uint16_t UART_TxFree(void);
+void UART_Flush(void);
+uint16_t UART_Available(void);
+uint8_t UART_ReadByte(uint8_t *Data);
+int16_t UART_ReadLine(uint8_t *Buf, uint16_t Size);
+int16_t UART_ReadFrame(uint8_t *Buf, uint16_t Size);
+void UART_SetRxCallback(void (*Func)(void));
 uint8_t get_UART_RecStatus(void);
 uint16_t get_UART_RecLength(void);
 void Reset_UART_RecStatus(void);
@@ -29,6 +112,7 @@ void Reset_UART_RecStatus(void);
         {
             UART_SendData(USART_RX_BUF[t]);
         }
+        // 或一次放入发送队列：UART_Write(USART_RX_BUF, get_UART_RecLength());
         Reset_UART_RecStatus();
     }
 
@@ -44,5 +128,24 @@ void Reset_UART_RecStatus(void);
         }
         Reset_UART_RecStatus();
     }
+
+    // 3.从环形缓冲区逐行取出数据，一次循环可以处理多条积压的命令
+    uint8_t line[64];
+    int16_t len;
+    while ((len = UART_ReadLine(line, sizeof(line))) >= 0)
+    {
+        // 处理line中的len个字节
+    }
+
+    // 4.格式化输出，浮点数以定点方式转换，不使用C库printf
+    UART_printf("%.2f,%d\n", 12.345f, -7); // 输出 "12.35,-7\n"
+
+    // 5.按帧取出数据（以总线空闲划分，适合不含行结束符的二进制协议），建议配合USART_RX_DMA使用
+    uint8_t frame[64];
+    int16_t len;
+    while ((len = UART_ReadFrame(frame, sizeof(frame))) >= 0)
+    {
+        // 处理frame中的len个字节
+    }
   ***************************************************
   */
@@ -0,0 +1,99 @@
+/**
+ * 上位机PID自整定仿真：对一阶惯性加纯滞后对象 G(s) = K e^(-Ls) / (Ts + 1)（离散化步长1）
+ * 运行继电反馈自整定（PID_AutoTune.c），
+ *   - 先比较测得的Ku、Pu与理论值（ωu满足 atan(ωT) + ωL = π，Ku = √(1 + (ωT)²) / K，Pu = 2π/ωu），
+ *     描述函数法为近似方法，继电反馈测得的Ku一般比理论值小10% ~ 30%；
+ *   - 再用各规则的整定结果做阶跃响应，输出系数、超调量和最终值
+ *     （ZN规则响应快、超调较大，TL规则超调小）。
+ *
+ * 编译（在工程根目录）：
+ *   gcc -IPID -ISystem PID/Host/pid_autotune_sim.c PID/PID.c PID/PID_AutoTune.c -lm -o pid_autotune_sim
+ * 使用：
+ *   pid_autotune_sim
+ *
+ * 整定失败，或任一规则的阶跃响应最终值与目标值相差超过SIM_MAX_ERROR时返回1。
+ */
+#include <stdio.h>
+#include <math.h>
+#include "PID.h"
+#include "PID_AutoTune.h"
+
+#define K 2.0f  // 对象增益
+#define T 50.0f // 时间常数（采样次数）
+#define L 10    // 纯滞后（采样次数）
+
+#define SIM_TARGET 10.0f   // 阶跃响应的目标值
+#define SIM_STEPS 2000     // 阶跃响应的仿真次数
+#define SIM_MAX_ERROR 0.1f // 允许的最终值误差
+
+static float delay[L], y;
+static int head;
+
+/**
+ * @brief  清零对象状态。
+ * @param  无
+ * @retval 无
+ */
+static void Plant_Reset(void)
+{
+    int i;
+
+    y = 0;
+    head = 0;
+    for (i = 0; i < L; i++)
+        delay[i] = 0;
+}
+
+/**
+ * @brief  对象仿真一步，u经过L次采样后作用于对象。
+ * @param  u 控制量。
+ * @retval 测量值
+ */
+static float Plant(float u)
+{
+    float ud = delay[head];
+    delay[head] = u;
+    head = (head + 1) % L;
+    y += (K * ud - y) / T;
+    return y;
+}
+
+int main(void)
+{
+    PID_AutoTune tune;
+    PID pid;
+    float w = 0.1f, in = 0, out, maxy;
+    int i, rule, failed = 0;
+
+    for (i = 0; i < 100; i++) // 牛顿迭代求ωu
+        w -= (atanf(w * T) + w * L - 3.14159265f) / (T / (1 + w * w * T * T) + L);
+    printf("theory: Ku = %.3f, Pu = %.1f\n", sqrtf(1 + w * w * T * T) / K, 2 * 3.14159265f / w);
+
+    Plant_Reset();
+    PID_AutoTune_Init(&tune, SIM_TARGET, 5, 2, 0.05f, 4, 10000);
+    while (PID_AutoTune_Status(&tune) == PID_TUNE_RUNNING)
+        in = Plant(PID_AutoTune_Update(&tune, in));
+    printf("relay:  Ku = %.3f, Pu = %.1f, status %d\n", tune.Ku, tune.Pu, PID_AutoTune_Status(&tune));
+    if (PID_AutoTune_Status(&tune) != PID_TUNE_DONE)
+        return 1;
+
+    for (rule = PID_TUNE_ZN_PID; rule <= PID_TUNE_TL_PI; rule++)
+    {
+        Plant_Reset();
+        PID_Init(&pid, 0, 0, 0, SIM_TARGET, -20, 20, -20, 20);
+        PID_AutoTune_Apply(&tune, &pid, rule, 1);
+        for (in = 0, maxy = SIM_TARGET, i = 0; i < SIM_STEPS; i++)
+        {
+            out = PID_Compute(&pid, in);
+            in = Plant(out);
+            if (in > maxy)
+                maxy = in;
+        }
+        printf("rule %d: Kp %.3f Ki %.4f Kd %.3f overshoot %.1f%% final %.3f%s\n",
+               rule, pid.Kp, pid.Ki, pid.Kd, (maxy - SIM_TARGET) / SIM_TARGET * 100, in,
+               fabsf(in - SIM_TARGET) > SIM_MAX_ERROR ? "  FAIL" : "");
+        if (fabsf(in - SIM_TARGET) > SIM_MAX_ERROR)
+            failed = 1;
+    }
+    return failed;
+}
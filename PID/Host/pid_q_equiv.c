@@ -0,0 +1,191 @@
+/**
+ * 上位机定点数PID一致性测试：同一组参数分别用浮点版本（PID.c）和定点版本（PID_q.c）运算，
+ * 比较两者的输出，位置式和增量式各做两项：
+ *   - 闭环：一阶惯性对象 + 噪声，输入在 -0.99 ~ 0.99 之间变化；
+ *   - 随机：目标值和输入值在整个Q15范围内随机取值（|偏差|可达2.0），
+ *     系数取二进制下精确的值，排除系数量化误差（偏差大时系数量化会带来数个LSB的差值）。
+ * 差值应在几个Q15 LSB以内。
+ *
+ * 编译（在工程根目录）：
+ *   gcc -IPID -ISystem PID/Host/pid_q_equiv.c PID/PID.c PID/PID_q.c -o pid_q_equiv
+ * 使用：
+ *   pid_q_equiv
+ *
+ * 任一项最大差值超过PID_EQUIV_MAX_LSB时返回1。
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "PID.h"
+#include "PID_q.h"
+
+#define PID_EQUIV_STEPS 100000 // 每项测试的运算次数
+#define PID_EQUIV_MAX_LSB 4    // 允许的最大差值（Q15 LSB）
+
+static int Failed;
+
+/**
+ * @brief  返回 -1.0 ~ 0.99997 之间的随机Q15数。
+ * @param  无
+ * @retval 随机数
+ */
+static q15_t Rand_Q15(void)
+{
+    return (q15_t)((rand() & 0xFFFF) - 32768);
+}
+
+/**
+ * @brief  输出一项测试结果。
+ * @param  Name 测试名称。
+ * @param  MaxDiff 最大差值（Q15 LSB）。
+ * @retval 无
+ */
+static void Report(const char *Name, long MaxDiff)
+{
+    printf("%-24s max diff = %ld LSB%s\n", Name, MaxDiff, MaxDiff > PID_EQUIV_MAX_LSB ? "  FAIL" : "");
+    if (MaxDiff > PID_EQUIV_MAX_LSB)
+        Failed = 1;
+}
+
+/**
+ * @brief  比较浮点与定点输出，更新最大差值。
+ * @param  Of 浮点输出。
+ * @param  Oq 定点输出。
+ * @param  MaxDiff 最大差值（Q15 LSB）。
+ * @retval 无
+ */
+static void Compare(float Of, q15_t Oq, long *MaxDiff)
+{
+    long d = labs((long)(Of * 32768.0f + (Of < 0 ? -0.5f : 0.5f)) - Oq);
+    if (d > *MaxDiff)
+        *MaxDiff = d;
+}
+
+/**
+ * @brief  位置式：闭环一阶对象。
+ * @param  无
+ * @retval 无
+ */
+static void Pos_ClosedLoop(void)
+{
+    PID f;
+    PID_q q;
+    float in = 0, of;
+    long maxdiff = 0;
+    long i;
+
+    // 目标值先量化为Q15，否则量化误差会在积分中逐步累积
+    PID_Init(&f, 0.8f, 0.05f, 0.1f, PID_Q15_TO_FLOAT(PID_Q15(0.3)), -0.9f, 0.9f, -0.5f, 0.5f);
+    PID_q_Init(&q, PID_Q_GAIN(0.8), PID_Q_GAIN(0.05), PID_Q_GAIN(0.1),
+               PID_Q15(0.3), PID_Q15(-0.9), PID_Q15(0.9), PID_Q15(-0.5), PID_Q15(0.5));
+    for (i = 0; i < PID_EQUIV_STEPS; i++)
+    {
+        in = PID_Q15_TO_FLOAT(PID_Q15(in)); // 两者使用相同的量化输入
+        of = PID_Compute(&f, in);
+        Compare(of, PID_q_Compute(&q, PID_Q15(in)), &maxdiff);
+        in += 0.2f * of + (rand() % 200 - 100) / 32768.0f; // 一阶对象 + 噪声
+        if (in > 0.99f)
+            in = 0.99f;
+        if (in < -0.99f)
+            in = -0.99f;
+    }
+    Report("positional closed-loop", maxdiff);
+}
+
+/**
+ * @brief  位置式：目标值和输入值在整个Q15范围内随机取值。
+ * @param  无
+ * @retval 无
+ */
+static void Pos_Random(void)
+{
+    PID f;
+    PID_q q;
+    q15_t target, in;
+    long maxdiff = 0;
+    long i;
+
+    PID_Init(&f, 0.75f, 0.0625f, 0.125f, 0, -0.9f, 0.9f, -1.0f, PID_Q15_TO_FLOAT(32767));
+    PID_q_Init(&q, PID_Q_GAIN(0.75), PID_Q_GAIN(0.0625), PID_Q_GAIN(0.125),
+               0, PID_Q15(-0.9), PID_Q15(0.9), -32768, 32767);
+    for (i = 0; i < PID_EQUIV_STEPS; i++)
+    {
+        if (i % 16 == 0) // 目标值每16次改变一次，期间积分可以累积
+        {
+            target = Rand_Q15();
+            PID_ResetTarget(&f, PID_Q15_TO_FLOAT(target));
+            PID_q_ResetTarget(&q, target);
+        }
+        in = Rand_Q15();
+        Compare(PID_Compute(&f, PID_Q15_TO_FLOAT(in)), PID_q_Compute(&q, in), &maxdiff);
+    }
+    Report("positional random", maxdiff);
+}
+
+/**
+ * @brief  增量式：闭环一阶对象。
+ * @param  无
+ * @retval 无
+ */
+static void Inc_ClosedLoop(void)
+{
+    IncPID f;
+    IncPID_q q;
+    float in = 0, of;
+    long maxdiff = 0;
+    long i;
+
+    IncPID_Init(&f, 0.3f, 0.05f, 0.02f, PID_Q15_TO_FLOAT(PID_Q15(0.3)), -0.5f, 0.5f);
+    IncPID_q_Init(&q, PID_Q_GAIN(0.3), PID_Q_GAIN(0.05), PID_Q_GAIN(0.02),
+                  PID_Q15(0.3), PID_Q15(-0.5), PID_Q15(0.5));
+    for (i = 0; i < PID_EQUIV_STEPS; i++)
+    {
+        in = PID_Q15_TO_FLOAT(PID_Q15(in));
+        of = IncPID_Compute(&f, in);
+        Compare(of, IncPID_q_Compute(&q, PID_Q15(in)), &maxdiff);
+        in += 0.2f * of + (rand() % 200 - 100) / 32768.0f;
+        if (in > 0.99f)
+            in = 0.99f;
+        if (in < -0.99f)
+            in = -0.99f;
+    }
+    Report("incremental closed-loop", maxdiff);
+}
+
+/**
+ * @brief  增量式：目标值和输入值在整个Q15范围内随机取值。
+ * @param  无
+ * @retval 无
+ */
+static void Inc_Random(void)
+{
+    IncPID f;
+    IncPID_q q;
+    q15_t target, in;
+    long maxdiff = 0;
+    long i;
+
+    IncPID_Init(&f, 0.25f, 0.0625f, 0.03125f, 0, -1.0f, PID_Q15_TO_FLOAT(32767));
+    IncPID_q_Init(&q, PID_Q_GAIN(0.25), PID_Q_GAIN(0.0625), PID_Q_GAIN(0.03125), 0, -32768, 32767);
+    for (i = 0; i < PID_EQUIV_STEPS; i++)
+    {
+        if (i % 16 == 0)
+        {
+            target = Rand_Q15();
+            IncPID_ResetTarget(&f, PID_Q15_TO_FLOAT(target));
+            IncPID_q_ResetTarget(&q, target);
+        }
+        in = Rand_Q15();
+        Compare(IncPID_Compute(&f, PID_Q15_TO_FLOAT(in)), IncPID_q_Compute(&q, in), &maxdiff);
+    }
+    Report("incremental random", maxdiff);
+}
+
+int main(void)
+{
+    srand(1);
+    Pos_ClosedLoop();
+    Pos_Random();
+    Inc_ClosedLoop();
+    Inc_Random();
+    return Failed;
+}
@@ -14,6 +14,7 @@
   */
 
 #include "PID.h"
+#include "profile.h"
 
 /**
  * @brief  位置式PID参数初始化
@@ -43,6 +44,14 @@ void PID_Init(PID *pid, float Kp, float Ki, float Kd, float target,
     pid->error = 0.0;
     pid->last_error = 0.0;
     pid->integral = 0.0;
+    pid->dMode = PID_D_ON_ERROR;
+    pid->dReady = 0;
+    pid->dAlpha = 1.0;
+    pid->last_input = 0.0;
+    pid->d_filtered = 0.0;
+    pid->awMode = PID_AW_NONE;
+    pid->saturated = PID_SAT_NONE;
+    pid->Kt = 1.0;
 }
 
 /**
@@ -84,18 +93,99 @@ void PID_Reset_pid(PID *pid, uint8_t K_x, float value)
 }
 
 /**
- * @brief  位置式PID运算。
+ * @brief  设置位置式PID微分方式及微分项低通滤波
+ * @param  pid PID参数结构体
+ * @param  dMode 微分方式
+ *      @arg 有效取值:
+ *          - \b PID_D_ON_ERROR : 对偏差求导（默认）
+ *          - \b PID_D_ON_MEASUREMENT : 对测量值求导，调用PID_ResetTarget()改变目标值时不产生微分冲击
+ * @param  dAlpha 微分项一阶低通滤波系数 d = d + dAlpha * (新微分值 - d)
+ *      @arg 取值: (0, 1]，越小滤波越强、相位滞后越大，1为不滤波
+ * @retval 无
+ */
+void PID_SetDerivative(PID *pid, uint8_t dMode, float dAlpha)
+{
+    if (dAlpha <= 0.0 || dAlpha > 1.0)
+        dAlpha = 1.0;
+    pid->dMode = dMode;
+    pid->dAlpha = dAlpha;
+}
+
+/**
+ * @brief  设置位置式PID抗积分饱和方式
+ * @param  pid PID参数结构体
+ * @param  awMode 抗积分饱和方式
+ *      @arg 有效取值:
+ *          - \b PID_AW_NONE : 只对积分项限幅，积分值持续累积（默认）
+ *          - \b PID_AW_CLAMP : 积分值限幅，使积分项不超过积分限幅，退出饱和时无需等待积分值回落
+ *          - \b PID_AW_CONDITIONAL : 输出饱和且偏差使输出继续趋向饱和时，本次不积分
+ *          - \b PID_AW_BACK_CALC : 积分项按 Kt * (限幅后输出 - 限幅前输出) 修正，输出饱和时积分项跟踪限幅值
+ * @param  Kt 反计算跟踪系数，仅PID_AW_BACK_CALC使用
+ *      @arg 取值: (0, 1]，1为一次修正到刚好饱和，越小修正越慢
+ * @retval 无
+ */
+void PID_SetAntiWindup(PID *pid, uint8_t awMode, float Kt)
+{
+    if (Kt <= 0.0 || Kt > 1.0)
+        Kt = 1.0;
+    pid->awMode = awMode;
+    pid->Kt = Kt;
+}
+
+/**
+ * @brief  获取位置式PID最近一次运算的输出饱和状态，外环可据此停止积分或调整目标值
+ * @param  pid PID参数结构体
+ * @retval 饱和状态
+ *      - \b PID_SAT_NONE : 未饱和
+ *      - \b PID_SAT_HIGH : 输出达到上限
+ *      - \b PID_SAT_LOW : 输出达到下限
+ */
+uint8_t PID_GetSaturation(const PID *pid)
+{
+    return pid->saturated;
+}
+
+/**
+ * @brief  位置式PID运算（PID_Compute()与PID_Compute_dt()共用）。
  * @param  pid PID参数结构体
  * @param  input 当前值
+ * @param  dt 积分步长，PID_Compute()为1
+ * @param  inv_dt 微分步长的倒数，PID_Compute()为1
  * @retval 位置式PID运算结果
  */
-float PID_Compute(PID *pid, float input)
+static float PID_Step(PID *pid, float input, float dt, float inv_dt)
 {
     pid->error = pid->target - input;                        // 计算误差
-    pid->integral += pid->error;                             // 累积误差
+    float integral = pid->integral + pid->error * dt;        // 累积误差
+
+    // 积分值限幅：积分项恰好达到积分限幅时的积分值
+    if (pid->awMode == PID_AW_CLAMP && pid->Ki != 0.0f)
+    {
+        float a = pid->minIntegral / pid->Ki, b = pid->maxIntegral / pid->Ki;
+        float lo = (a < b) ? a : b, hi = (a < b) ? b : a;
+        if (integral > hi)
+            integral = hi;
+        else if (integral < lo)
+            integral = lo;
+    }
+
     float p_term = pid->Kp * pid->error;                     // 比例项
-    float i_term = pid->Ki * pid->integral;                  // 积分项
-    float d_term = pid->Kd * (pid->error - pid->last_error); // 微分项
+    float i_term = pid->Ki * integral;                       // 积分项
+
+    // 微分项：对偏差或测量值求导后一阶低通滤波
+    if (!pid->dReady) // 第一次运算，没有上次测量值
+    {
+        pid->last_input = input;
+        pid->dReady = 1;
+    }
+    float d_raw = (pid->dMode == PID_D_ON_MEASUREMENT) ? (pid->last_input - input)
+                                                       : (pid->error - pid->last_error);
+    if (pid->dAlpha < 1.0f)
+        pid->d_filtered += pid->dAlpha * (d_raw - pid->d_filtered);
+    else
+        pid->d_filtered = d_raw;
+    float d_term = pid->Kd * pid->d_filtered * inv_dt;
+    pid->last_input = input;
 
     // 积分限幅
     if (i_term > pid->maxIntegral)
@@ -106,17 +196,73 @@ float PID_Compute(PID *pid, float input)
     // 更新上次误差
     pid->last_error = pid->error;
 
-    float PID_Output = p_term + i_term + d_term;
+    float unsat = p_term + i_term + d_term;
+    float PID_Output = unsat;
 
     // PID输出限幅
+    pid->saturated = PID_SAT_NONE;
     if (PID_Output > pid->maxOutput)
+    {
         PID_Output = pid->maxOutput;
+        pid->saturated = PID_SAT_HIGH;
+    }
     else if (PID_Output < pid->minOutput)
+    {
         PID_Output = pid->minOutput;
+        pid->saturated = PID_SAT_LOW;
+    }
+
+    // 输出饱和时的积分处理
+    if (pid->saturated != PID_SAT_NONE)
+    {
+        if (pid->awMode == PID_AW_CONDITIONAL)
+        {
+            float push = pid->Ki * pid->error; // 本次积分使输出变化的方向
+            if ((pid->saturated == PID_SAT_HIGH && push > 0.0f) ||
+                (pid->saturated == PID_SAT_LOW && push < 0.0f))
+                integral = pid->integral;
+        }
+        else if (pid->awMode == PID_AW_BACK_CALC && pid->Ki != 0.0f)
+        {
+            integral += pid->Kt * (PID_Output - unsat) / pid->Ki;
+        }
+    }
+    pid->integral = integral;
 
     return PID_Output;
 }
 
+/**
+ * @brief  位置式PID运算，每次调用为一个采样周期，Ki、Kd以采样周期为时间单位。
+ * @param  pid PID参数结构体
+ * @param  input 当前值
+ * @retval 位置式PID运算结果
+ */
+float PID_Compute(PID *pid, float input)
+{
+    float out;
+
+    PROF_BEGIN(PID_Compute);
+    out = PID_Step(pid, input, 1.0f, 1.0f);
+    PROF_END(PID_Compute);
+    return out;
+}
+
+/**
+ * @brief  按采样周期运算位置式PID，积分为 偏差 x dt 的累加，微分为 偏差变化量 / dt。
+ *      Ki单位为1/s、Kd单位为s，控制频率改变时无需重新整定参数；
+ *      与PID_Compute()的系数换算：Ki = Ki' / dt，Kd = Kd' x dt（Ki'、Kd'为PID_Compute()使用的系数）。
+ *      同一个PID对象应始终使用同一种运算函数（两者的积分值单位不同）。
+ * @param  pid PID参数结构体
+ * @param  input 当前值
+ * @param  dt 距上次运算的时间（s），必须大于0
+ * @retval 位置式PID运算结果
+ */
+float PID_Compute_dt(PID *pid, float input, float dt)
+{
+    return PID_Step(pid, input, dt, 1.0f / dt);
+}
+
 /**
  * @brief  增量式PID参数初始化
  * @param  incpid PID参数结构体
@@ -182,18 +328,20 @@ void IncPID_Reset_pid(IncPID *incpid, uint8_t K_x, float value)
 }
 
 /**
- * @brief  增量式PID运算。
+ * @brief  增量式PID运算（IncPID_Compute()与IncPID_Compute_dt()共用）。
  * @param  incpid PID参数结构体
  * @param  input 当前值
+ * @param  dt 积分步长，IncPID_Compute()为1
+ * @param  inv_dt 微分步长的倒数，IncPID_Compute()为1
  * @retval 增量式PID运算结果
  */
-float IncPID_Compute(IncPID *incpid, float input)
+static float IncPID_Step(IncPID *incpid, float input, float dt, float inv_dt)
 {
     incpid->error = incpid->target - input;
 
-    float p_term = incpid->Kp * (incpid->error - incpid->last_error);                          // 比例项
-    float i_term = incpid->Ki * incpid->error;                                                 // 积分项
-    float d_term = incpid->Kd * (incpid->error - 2 * incpid->last_error + incpid->prev_error); // 微分项
+    float p_term = incpid->Kp * (incpid->error - incpid->last_error);                                   // 比例项
+    float i_term = incpid->Ki * incpid->error * dt;                                                     // 积分项
+    float d_term = incpid->Kd * (incpid->error - 2 * incpid->last_error + incpid->prev_error) * inv_dt; // 微分项
 
     // 更新误差
     incpid->prev_error = incpid->last_error;
@@ -210,6 +358,124 @@ float IncPID_Compute(IncPID *incpid, float input)
     return incpid->IncPID_Output;
 }
 
+/**
+ * @brief  增量式PID运算，每次调用为一个采样周期，Ki、Kd以采样周期为时间单位。
+ * @param  incpid PID参数结构体
+ * @param  input 当前值
+ * @retval 增量式PID运算结果
+ */
+float IncPID_Compute(IncPID *incpid, float input)
+{
+    return IncPID_Step(incpid, input, 1.0f, 1.0f);
+}
+
+/**
+ * @brief  按采样周期运算增量式PID，Ki单位为1/s、Kd单位为s（换算关系见PID_Compute_dt()）。
+ * @param  incpid PID参数结构体
+ * @param  input 当前值
+ * @param  dt 距上次运算的时间（s），必须大于0
+ * @retval 增量式PID运算结果
+ */
+float IncPID_Compute_dt(IncPID *incpid, float input, float dt)
+{
+    return IncPID_Step(incpid, input, dt, 1.0f / dt);
+}
+
+/**
+ * @brief  批量位置式PID初始化，全部控制器的参数及状态清零
+ * @param  batch 批量PID参数结构体
+ * @param  Num 控制器个数
+ *     @arg 取值: 1 - PID_BATCH_MAX
+ * @retval 无
+ */
+void PID_Batch_Init(PID_Batch *batch, uint8_t Num)
+{
+    uint8_t i;
+
+    if (Num > PID_BATCH_MAX)
+        Num = PID_BATCH_MAX;
+    batch->Num = Num;
+    for (i = 0; i < PID_BATCH_MAX; i++)
+        PID_Batch_Set(batch, i, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
+}
+
+/**
+ * @brief  设置批量位置式PID中一个控制器的参数，并清零其状态
+ * @param  batch 批量PID参数结构体
+ * @param  Index 控制器序号
+ *     @arg 取值: 0 - PID_BATCH_MAX-1
+ * @param  Kp 比例项系数
+ * @param  Ki 积分项系数
+ * @param  Kd 微分项系数
+ * @param  target 目标值
+ * @param  minIntegral 积分限幅-最小值
+ * @param  maxIntegral 积分限幅-最大值
+ * @param  minOutput PID输出限幅-最小值
+ * @param  maxOutput PID输出限幅-最大值
+ * @retval 无
+ */
+void PID_Batch_Set(PID_Batch *batch, uint8_t Index, float Kp, float Ki, float Kd, float target,
+                   float minIntegral, float maxIntegral,
+                   float minOutput, float maxOutput)
+{
+    if (Index >= PID_BATCH_MAX)
+        return;
+    batch->Kp[Index] = Kp;
+    batch->Ki[Index] = Ki;
+    batch->Kd[Index] = Kd;
+    batch->target[Index] = target;
+    batch->minIntegral[Index] = minIntegral;
+    batch->maxIntegral[Index] = maxIntegral;
+    batch->minOutput[Index] = minOutput;
+    batch->maxOutput[Index] = maxOutput;
+    batch->error[Index] = 0.0;
+    batch->last_error[Index] = 0.0;
+    batch->integral[Index] = 0.0;
+}
+
+/**
+ * @brief  批量位置式PID运算，依次完成batch->Num个控制器的运算，每个控制器的运算过程与PID_Compute()相同。
+ * @param  batch 批量PID参数结构体
+ * @param  input 各控制器的当前值，batch->Num个
+ * @param  output 各控制器的运算结果，batch->Num个
+ * @retval 无
+ */
+void PID_Batch_Compute(PID_Batch *batch, const float *input, float *output)
+{
+    uint8_t i;
+    float error, integral, p_term, i_term, d_term, PID_Output;
+
+    for (i = 0; i < batch->Num; i++)
+    {
+        error = batch->target[i] - input[i];                    // 计算误差
+        integral = batch->integral[i] + error;                  // 累积误差
+        batch->integral[i] = integral;
+        p_term = batch->Kp[i] * error;                          // 比例项
+        i_term = batch->Ki[i] * integral;                       // 积分项
+        d_term = batch->Kd[i] * (error - batch->last_error[i]); // 微分项
+
+        // 积分限幅
+        if (i_term > batch->maxIntegral[i])
+            i_term = batch->maxIntegral[i];
+        else if (i_term < batch->minIntegral[i])
+            i_term = batch->minIntegral[i];
+
+        // 更新误差
+        batch->error[i] = error;
+        batch->last_error[i] = error;
+
+        PID_Output = p_term + i_term + d_term;
+
+        // PID输出限幅
+        if (PID_Output > batch->maxOutput[i])
+            PID_Output = batch->maxOutput[i];
+        else if (PID_Output < batch->minOutput[i])
+            PID_Output = batch->minOutput[i];
+
+        output[i] = PID_Output;
+    }
+}
+
 /**
  * @brief  指数加权移动平均滤波
  * @param  input 输入值
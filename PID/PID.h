@@ -22,6 +22,18 @@
 #define K_i 2
 #define K_d 3
 
+#define PID_D_ON_ERROR 0       // 微分项对偏差求导（目标值突变时输出产生尖峰）
+#define PID_D_ON_MEASUREMENT 1 // 微分项对测量值求导（目标值突变时微分项不变）
+
+#define PID_AW_NONE 0        // 只对积分项限幅，积分值持续累积（默认）
+#define PID_AW_CLAMP 1       // 积分值限幅，积分项不超过积分限幅
+#define PID_AW_CONDITIONAL 2 // 条件积分，输出饱和且偏差使输出继续趋向饱和时停止积分
+#define PID_AW_BACK_CALC 3   // 反计算，按 Kt * (限幅后输出 - 限幅前输出) 修正积分项
+
+#define PID_SAT_NONE 0 // 输出未饱和
+#define PID_SAT_HIGH 1 // 输出达到上限
+#define PID_SAT_LOW 2  // 输出达到下限
+
 /**
  * PID的作用概述：
  * 1、P产生响应速度和力度，过小响应慢，过大会产生振荡，是I和D的基础。
@@ -40,6 +52,14 @@ typedef struct
     float integral;                 // 积分值
     float maxIntegral, minIntegral; // 积分限幅
     float maxOutput, minOutput;     // 输出限幅
+    uint8_t dMode;                  // 微分方式，PID_D_ON_ERROR 或 PID_D_ON_MEASUREMENT
+    uint8_t dReady;                 // 是否已记录上次测量值
+    float dAlpha;                   // 微分项一阶低通滤波系数，取值(0, 1]，1为不滤波
+    float last_input;               // 上次测量值
+    float d_filtered;               // 滤波后的微分值（未乘Kd）
+    uint8_t awMode;                 // 抗积分饱和方式，PID_AW_xxx
+    uint8_t saturated;              // 最近一次运算的输出饱和状态，PID_SAT_xxx
+    float Kt;                       // 反计算跟踪系数，取值(0, 1]
 } PID;
 
 void PID_Init(PID *pid, float Kp, float Ki, float Kd, float target,
@@ -47,7 +67,11 @@ void PID_Init(PID *pid, float Kp, float Ki, float Kd, float target,
               float minOutput, float maxOutput);
 void PID_ResetTarget(PID *pid, float target);
 void PID_Reset_pid(PID *pid, uint8_t Kx, float coefficient);
+void PID_SetDerivative(PID *pid, uint8_t dMode, float dAlpha);
+void PID_SetAntiWindup(PID *pid, uint8_t awMode, float Kt);
+uint8_t PID_GetSaturation(const PID *pid);
 float PID_Compute(PID *pid, float input);
+float PID_Compute_dt(PID *pid, float input, float dt);
 
 /******************************************************************/
 
@@ -69,6 +93,35 @@ void IncPID_Init(IncPID *incpid, float Kp, float Ki, float Kd, float target,
 void IncPID_ResetTarget(IncPID *incpid, float target);
 void IncPID_Reset_pid(IncPID *incpid, uint8_t Kx, float coefficient);
 float IncPID_Compute(IncPID *incpid, float input);
+float IncPID_Compute_dt(IncPID *incpid, float input, float dt);
+
+/******************************************************************/
+
+/************************** 批量位置式PID **************************/
+
+#define PID_BATCH_MAX 8 // 一组最多的控制器个数
+
+/**
+ * 一组位置式PID，各参数按数组存放（数组结构体），一次调用完成全部控制器的运算，
+ * 运算过程与PID_Compute()相同，适合每个控制周期需要运算多路PID的场合（如多个车轮转速环）。
+ */
+typedef struct
+{
+    float Kp[PID_BATCH_MAX], Ki[PID_BATCH_MAX], Kd[PID_BATCH_MAX]; // 比例、积分、微分系数
+    float target[PID_BATCH_MAX];                                   // 目标值
+    float error[PID_BATCH_MAX];                                    // 偏差值
+    float last_error[PID_BATCH_MAX];                               // 前一次偏差
+    float integral[PID_BATCH_MAX];                                 // 积分值
+    float maxIntegral[PID_BATCH_MAX], minIntegral[PID_BATCH_MAX];  // 积分限幅
+    float maxOutput[PID_BATCH_MAX], minOutput[PID_BATCH_MAX];      // 输出限幅
+    uint8_t Num;                                                   // 控制器个数
+} PID_Batch;
+
+void PID_Batch_Init(PID_Batch *batch, uint8_t Num);
+void PID_Batch_Set(PID_Batch *batch, uint8_t Index, float Kp, float Ki, float Kd, float target,
+                   float minIntegral, float maxIntegral,
+                   float minOutput, float maxOutput);
+void PID_Batch_Compute(PID_Batch *batch, const float *input, float *output);
 
 /******************************************************************/
 
@@ -80,6 +133,93 @@ float EWMA_filter(float input, float filtered_value, float alpha);
 
 #endif /* __PID_H */
 
+/**
+  ***************************************************
+  * @example 微分先行与微分滤波例程
+  * @brief   对测量值求导，目标值从370跳变到800时输出不产生尖峰；微分项滤波系数0.2抑制转速测量噪声
+  ***************************************************
+    PID MotorPID;
+
+    PID_Init(&MotorPID, 0.015, 0.014, 0.001, 370, -1850, 1850, 0, 100);
+    PID_SetDerivative(&MotorPID, PID_D_ON_MEASUREMENT, 0.2);
+
+    PWM_SetCompare(PID_Compute(&MotorPID, speed));
+    PID_ResetTarget(&MotorPID, 800);                // 只有比例项随目标值跳变
+  ***************************************************
+  */
+
+/**
+  ***************************************************
+  * @example 抗积分饱和例程
+  * @brief   内环使用反计算抗积分饱和，外环在内环饱和时停止积分
+  ***************************************************
+    PID SpeedPID, PosPID;
+
+    PID_Init(&SpeedPID, 0.015, 0.014, 0.001, 0, -100, 100, 0, 100);
+    PID_SetAntiWindup(&SpeedPID, PID_AW_BACK_CALC, 0.5);
+    PID_Init(&PosPID, 2.0, 0.01, 0, 0, -500, 500, -1850, 1850);
+    PID_SetAntiWindup(&PosPID, PID_AW_CLAMP, 0);
+
+    PID_ResetTarget(&SpeedPID, PID_Compute(&PosPID, position));
+    PWM_SetCompare(PID_Compute(&SpeedPID, speed));
+    if (PID_GetSaturation(&SpeedPID) != PID_SAT_NONE)
+        PosPID.integral -= PosPID.error;            // 撤销外环本次积分
+  ***************************************************
+  */
+
+/**
+  ***************************************************
+  * @example 批量位置式PID例程
+  * @brief   4个车轮转速环在同一个控制周期中一次运算
+  ***************************************************
+    PID_Batch WheelPID;
+    float speed[4], pwm[4];
+    uint8_t i;
+
+    PID_Batch_Init(&WheelPID, 4);
+    for (i = 0; i < 4; i++)
+        PID_Batch_Set(&WheelPID, i, 0.015, 0.014, 0.001, 370, -1850, 1850, 0, 100);
+
+    // 控制周期中
+    speed[0] = ...;                                 // 读取4个车轮的转速
+    PID_Batch_Compute(&WheelPID, speed, pwm);       // pwm[i]与N次PID_Compute()的结果相同
+  ***************************************************
+  */
+
+/**
+  ***************************************************
+  * @example 批量PID耗时测试例程
+  * @brief   用Delay_Cycles()（delay.h）测量N = 1 ~ PID_BATCH_MAX时，批量运算与N次PID_Compute()平均每个控制器消耗的CPU周期数
+  ***************************************************
+    static PID pid[PID_BATCH_MAX];
+    static PID_Batch batch;
+    float in[PID_BATCH_MAX] = {0}, out[PID_BATCH_MAX];
+    uint32_t t0, t1, per_single[PID_BATCH_MAX + 1], per_batch[PID_BATCH_MAX + 1];
+    uint8_t n, i;
+
+    for (n = 1; n <= PID_BATCH_MAX; n++)
+    {
+        PID_Batch_Init(&batch, n);
+        for (i = 0; i < n; i++)
+        {
+            PID_Init(&pid[i], 0.8, 0.05, 0.1, 100, -50, 50, -100, 100);
+            PID_Batch_Set(&batch, i, 0.8, 0.05, 0.1, 100, -50, 50, -100, 100);
+        }
+
+        t0 = Delay_Cycles();
+        for (i = 0; i < n; i++)
+            out[i] = PID_Compute(&pid[i], in[i]);
+        t1 = Delay_Cycles();
+        per_single[n] = (t1 - t0) / n;
+
+        t0 = Delay_Cycles();
+        PID_Batch_Compute(&batch, in, out);
+        t1 = Delay_Cycles();
+        per_batch[n] = (t1 - t0) / n;
+    }
+  ***************************************************
+  */
+
 /************************************************************************
  *        PID控制例程 - openMV寻迹小车 (MSP430F5529 阿克曼转向小车)        *
  ************************************************************************
@@ -92,6 +232,7 @@ float EWMA_filter(float input, float filtered_value, float alpha);
 #include "Hardware/Encoder/Encoder.h"
 #include "Hardware/UART/MSP430F5529_UART.h"
 #include "PID/PID.h"
+#include "PID/PID_Cmd.h"
 
 void main(void)
 {
@@ -121,6 +262,13 @@ void main(void)
     float Servo_now = 0;
     float Servo_pidout = 0;
 
+    // 可通过串口命令调节的PID对象
+    const PID_CmdObj PidObjs[] = {
+        {"motor", &MotorPID, PID_CMD_POS},
+        {"servo", &ServoPID, PID_CMD_INC},
+    };
+    PID_Cmd_Bind(PidObjs, 2);
+
     OLED_ShowString(1, 1, "Snow:", 8);
     OLED_ShowString(3, 1, "Spidout:", 8);
     OLED_ShowString(5, 1, "Mnow:", 8);
@@ -132,35 +280,12 @@ void main(void)
     uint8_t runFlag = 0;
     while(1)
     {
-        // 串口1接收pid参数
+        // 串口1接收pid参数，格式：set motor Kp 1.234 或 get motor（见PID_Cmd.h）
         if(get_Uart_RecStatus(USCI_A1_BASE))
         {
-            uint8_t i;
-            char temp_pid[7];
-            float uart_p, uart_i, uart_d;
-            // 串口调节pid，格式：p1.234* 或 i1.234* 或 d1.234*
-            if(UART1_RX_BUF[0] == 'p' || UART1_RX_BUF[0] == 'i' || UART1_RX_BUF[0] == 'd')
+            UART1_RX_BUF[get_Uart_RecLength(USCI_A1_BASE)] = '\0';
+            if(Cmd_Exec(PID_CmdTable, PID_CMD_NUM, (char *)UART1_RX_BUF, 0) == CMD_OK)
             {
-                // 读取串口传入的pid值
-                for(i = 0; i < get_Uart_RecLength(USCI_A1_BASE) - 1; i++)
-                {
-                    temp_pid[i] = UART1_RX_BUF[i + 1];
-                }
-                if(UART1_RX_BUF[0] == 'p')
-                {
-                    sscanf(temp_pid, "%f", &uart_p);
-                    PID_Reset_pid(&MotorPID, K_p, uart_p);
-                }
-                if(UART1_RX_BUF[0] == 'i')
-                {
-                    sscanf(temp_pid, "%f", &uart_i);
-                    PID_Reset_pid(&MotorPID, K_i, uart_i);
-                }
-                if(UART1_RX_BUF[0] == 'd')
-                {
-                    sscanf(temp_pid, "%f", &uart_d);
-                    PID_Reset_pid(&MotorPID, K_d, uart_d);
-                }
                 UART_printf(USCI_A1_BASE, "OK\n");
             }
             else
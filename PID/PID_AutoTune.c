@@ -0,0 +1,193 @@
+#include "PID_AutoTune.h"
+#include "math.h"
+
+#define PID_TUNE_PI 3.14159265f
+
+/**
+ * @brief  继电反馈自整定初始化，开始整定
+ * @param  tune 自整定结构体
+ * @param  target 目标值，测量值在其附近振荡
+ * @param  outCenter 继电器输出中心值，一般为测量值稳定在目标值附近时的输出
+ * @param  outStep 继电器输出幅值，输出在 outCenter ± outStep 之间切换
+ * @param  hysteresis 回差，应略大于测量噪声的峰峰值，防止噪声引起继电器抖动
+ * @param  cycles 测量的振荡周期数，取平均值（第一个周期为过渡过程，不计入）
+ *      @arg 取值: 1 ~ PID_TUNE_CYCLES_MAX
+ * @param  maxSamples 超时采样次数，超过后整定失败
+ * @retval 无
+ */
+void PID_AutoTune_Init(PID_AutoTune *tune, float target, float outCenter, float outStep,
+                       float hysteresis, uint8_t cycles, uint32_t maxSamples)
+{
+    if (cycles < 1)
+        cycles = 1;
+    else if (cycles > PID_TUNE_CYCLES_MAX)
+        cycles = PID_TUNE_CYCLES_MAX;
+
+    tune->target = target;
+    tune->outCenter = outCenter;
+    tune->outStep = outStep;
+    tune->hysteresis = hysteresis;
+    tune->cycles = cycles;
+    tune->maxSamples = maxSamples;
+    tune->status = PID_TUNE_RUNNING;
+    tune->relayHigh = 1;
+    tune->count = 0;
+    tune->samples = 0;
+    tune->lastRise = 0;
+    tune->peakMax = target;
+    tune->peakMin = target;
+    tune->sumPeriod = 0.0;
+    tune->sumAmp = 0.0;
+    tune->Pu = 0.0;
+    tune->Ku = 0.0;
+}
+
+/**
+ * @brief  自整定运算，每个控制周期调用一次，代替PID_Compute()
+ * @param  tune 自整定结构体
+ * @param  input 当前值
+ * @retval 继电器输出；整定结束后返回outCenter
+ */
+float PID_AutoTune_Update(PID_AutoTune *tune, float input)
+{
+    float amp;
+
+    if (tune->status != PID_TUNE_RUNNING)
+        return tune->outCenter;
+
+    tune->samples++;
+    if (input > tune->peakMax)
+        tune->peakMax = input;
+    if (input < tune->peakMin)
+        tune->peakMin = input;
+
+    if (tune->relayHigh && input > tune->target + tune->hysteresis)
+    {
+        // 测量值向上越过目标值，一个完整周期结束
+        tune->relayHigh = 0;
+        if (tune->count > 0 && tune->count <= tune->cycles) // 上一个周期完整且不是第一个周期
+        {
+            amp = (tune->peakMax - tune->peakMin) / 2;
+            tune->sumPeriod += (float)(tune->samples - tune->lastRise);
+            tune->sumAmp += amp;
+        }
+        if (tune->count == tune->cycles)
+        {
+            tune->Pu = tune->sumPeriod / tune->cycles;
+            amp = tune->sumAmp / tune->cycles;
+            amp = amp * amp - tune->hysteresis * tune->hysteresis;
+            if (amp > 0.0f)
+            {
+                tune->Ku = 4 * tune->outStep / (PID_TUNE_PI * sqrtf(amp));
+                tune->status = PID_TUNE_DONE;
+            }
+            else
+            {
+                tune->status = PID_TUNE_FAILED; // 振幅小于回差，继电器被噪声触发
+            }
+            return tune->outCenter;
+        }
+        tune->count++;
+        tune->lastRise = tune->samples;
+        tune->peakMax = input;
+        tune->peakMin = input;
+    }
+    else if (!tune->relayHigh && input < tune->target - tune->hysteresis)
+    {
+        tune->relayHigh = 1;
+    }
+
+    if (tune->samples >= tune->maxSamples)
+    {
+        tune->status = PID_TUNE_FAILED;
+        return tune->outCenter;
+    }
+
+    return tune->relayHigh ? tune->outCenter + tune->outStep : tune->outCenter - tune->outStep;
+}
+
+/**
+ * @brief  获取自整定状态
+ * @param  tune 自整定结构体
+ * @retval 状态值
+ *      - \b PID_TUNE_RUNNING : 正在整定
+ *      - \b PID_TUNE_DONE : 整定完成
+ *      - \b PID_TUNE_FAILED : 整定失败（超时或振幅小于回差）
+ */
+uint8_t PID_AutoTune_Status(const PID_AutoTune *tune)
+{
+    return tune->status;
+}
+
+/**
+ * @brief  按整定规则计算PID参数
+ * @param  tune 自整定结构体
+ * @param  rule 整定规则
+ *      @arg 有效取值:
+ *          - \b PID_TUNE_ZN_PID : Ziegler–Nichols PID
+ *          - \b PID_TUNE_ZN_PI : Ziegler–Nichols PI
+ *          - \b PID_TUNE_TL_PID : Tyreus–Luyben PID
+ *          - \b PID_TUNE_TL_PI : Tyreus–Luyben PI
+ * @param  dt 控制周期（s）。参数用于PID_Compute()时取1（以采样周期为时间单位），用于PID_Compute_dt()时取实际周期
+ * @param  Kp Ki Kd 计算结果
+ * @retval 1: 成功  0: 整定未完成
+ */
+uint8_t PID_AutoTune_Gains(const PID_AutoTune *tune, uint8_t rule, float dt, float *Kp, float *Ki, float *Kd)
+{
+    float Pu = tune->Pu * dt, Ti, Td;
+
+    if (tune->status != PID_TUNE_DONE)
+        return 0;
+
+    switch (rule)
+    {
+    case PID_TUNE_ZN_PI:
+        *Kp = 0.45f * tune->Ku;
+        Ti = Pu / 1.2f;
+        Td = 0.0f;
+        break;
+    case PID_TUNE_TL_PID:
+        *Kp = tune->Ku / 2.2f;
+        Ti = 2.2f * Pu;
+        Td = Pu / 6.3f;
+        break;
+    case PID_TUNE_TL_PI:
+        *Kp = tune->Ku / 3.2f;
+        Ti = 2.2f * Pu;
+        Td = 0.0f;
+        break;
+    default: // PID_TUNE_ZN_PID
+        *Kp = 0.6f * tune->Ku;
+        Ti = Pu / 2.0f;
+        Td = Pu / 8.0f;
+        break;
+    }
+    *Ki = *Kp / Ti;
+    *Kd = *Kp * Td;
+    return 1;
+}
+
+/**
+ * @brief  按整定规则计算PID参数并写入PID对象，同时清除积分值和微分历史；
+ *      目标值、限幅及PID_SetDerivative()/PID_SetAntiWindup()的设置保持不变
+ * @param  tune 自整定结构体
+ * @param  pid PID参数结构体，需已用PID_Init()设置目标值和限幅
+ * @param  rule 整定规则，见PID_AutoTune_Gains()
+ * @param  dt 控制周期，见PID_AutoTune_Gains()
+ * @retval 1: 成功  0: 整定未完成，PID对象未修改
+ */
+uint8_t PID_AutoTune_Apply(const PID_AutoTune *tune, PID *pid, uint8_t rule, float dt)
+{
+    float Kp, Ki, Kd;
+
+    if (!PID_AutoTune_Gains(tune, rule, dt, &Kp, &Ki, &Kd))
+        return 0;
+    pid->Kp = Kp;
+    pid->Ki = Ki;
+    pid->Kd = Kd;
+    pid->integral = 0.0;
+    pid->last_error = 0.0;
+    pid->d_filtered = 0.0;
+    pid->dReady = 0;
+    return 1;
+}
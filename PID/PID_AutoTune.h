@@ -0,0 +1,83 @@
+#ifndef __PID_AUTOTUNE_H
+#define __PID_AUTOTUNE_H
+
+#include "stdint.h"
+#include "PID.h"
+
+/**
+ * 继电反馈（Åström–Hägglund）PID参数自整定。
+ * 整定期间用继电器输出代替PID输出：测量值低于 目标值 - 回差 时输出 中心值 + 幅值，
+ * 高于 目标值 + 回差 时输出 中心值 - 幅值，对象在目标值附近产生等幅振荡。
+ * 测得振荡周期Pu和测量值振幅a后，临界增益 Ku = 4d / (π√(a² - ε²))（d为继电器幅值，ε为回差），
+ * 再按Ziegler–Nichols或Tyreus–Luyben规则计算PID参数，由PID_AutoTune_Apply()写入PID对象（只修改系数并清除积分和微分历史）。
+ * 要求：输出增大时测量值增大（正作用）；继电器幅值应足够使测量值越过目标值，回差应略大于测量噪声。
+ * 一阶惯性加纯滞后对象的自整定仿真见PID/Host/pid_autotune_sim.c（在电脑上编译运行）。
+ */
+
+#define PID_TUNE_ZN_PID 0 // Ziegler–Nichols PID：Kp = 0.6Ku，Ti = Pu/2，Td = Pu/8（响应快，超调较大）
+#define PID_TUNE_ZN_PI 1  // Ziegler–Nichols PI：Kp = 0.45Ku，Ti = Pu/1.2
+#define PID_TUNE_TL_PID 2 // Tyreus–Luyben PID：Kp = Ku/2.2，Ti = 2.2Pu，Td = Pu/6.3（超调小，适合大多数对象）
+#define PID_TUNE_TL_PI 3  // Tyreus–Luyben PI：Kp = Ku/3.2，Ti = 2.2Pu
+
+#define PID_TUNE_RUNNING 0 // 正在整定
+#define PID_TUNE_DONE 1    // 整定完成
+#define PID_TUNE_FAILED 2  // 超时未产生稳定振荡
+
+#define PID_TUNE_CYCLES_MAX 8 // 最多测量的振荡周期数
+
+typedef struct
+{
+    // 整定参数
+    float target;           // 目标值（振荡中心）
+    float outCenter;        // 继电器输出中心值
+    float outStep;          // 继电器输出幅值d
+    float hysteresis;       // 回差ε
+    uint8_t cycles;         // 测量的振荡周期数（不含第一个周期）
+    uint32_t maxSamples;    // 超时采样次数
+    // 运行状态
+    uint8_t status;         // PID_TUNE_xxx
+    uint8_t relayHigh;      // 继电器当前是否输出高电平
+    uint8_t count;          // 已完成的振荡周期数（含第一个周期）
+    uint32_t samples;       // 已运算次数
+    uint32_t lastRise;      // 上一次测量值向上越过目标值（继电器切换为低）时的采样序号
+    float peakMax, peakMin; // 当前周期测量值的最大、最小值
+    float sumPeriod;        // 周期累加（采样次数）
+    float sumAmp;           // 振幅累加
+    // 结果
+    float Pu;               // 振荡周期（采样次数）
+    float Ku;               // 临界增益
+} PID_AutoTune;
+
+void PID_AutoTune_Init(PID_AutoTune *tune, float target, float outCenter, float outStep,
+                       float hysteresis, uint8_t cycles, uint32_t maxSamples);
+float PID_AutoTune_Update(PID_AutoTune *tune, float input);
+uint8_t PID_AutoTune_Status(const PID_AutoTune *tune);
+uint8_t PID_AutoTune_Gains(const PID_AutoTune *tune, uint8_t rule, float dt, float *Kp, float *Ki, float *Kd);
+uint8_t PID_AutoTune_Apply(const PID_AutoTune *tune, PID *pid, uint8_t rule, float dt);
+
+#endif /* __PID_AUTOTUNE_H */
+
+/**
+  ***************************************************
+  * @example PID自整定例程
+  * @brief   电机转速环，目标转速370，整定期间PWM在50 ± 30之间切换，完成后参数写入MotorPID
+  ***************************************************
+    PID MotorPID;
+    PID_AutoTune Tune;
+
+    PID_Init(&MotorPID, 0, 0, 0, 370, -1850, 1850, 0, 100); // 先设置好目标值和限幅
+    PID_AutoTune_Init(&Tune, 370, 50, 30, 5, 4, 20000);
+
+    // 控制周期中
+    if (PID_AutoTune_Status(&Tune) == PID_TUNE_RUNNING)
+    {
+        PWM_SetCompare(PID_AutoTune_Update(&Tune, speed));
+        if (PID_AutoTune_Status(&Tune) == PID_TUNE_DONE)
+            PID_AutoTune_Apply(&Tune, &MotorPID, PID_TUNE_TL_PID, 1); // 用PID_Compute()时dt为1
+    }
+    else
+    {
+        PWM_SetCompare(PID_Compute(&MotorPID, speed));
+    }
+  ***************************************************
+  */
@@ -0,0 +1,134 @@
+#include "PID_Cascade.h"
+
+/**
+ * @brief  写入调度得到的系数。PID中积分项为 Ki * integral，Ki变化时按 Ki旧 / Ki新 缩放积分值，
+ *      使积分项输出保持不变（无扰切换）；Ki变为0时积分值保持不变。
+ * @param  pid PID参数结构体
+ * @param  Kp Ki Kd 新系数
+ * @retval 无
+ */
+static void PID_SetGains(PID *pid, float Kp, float Ki, float Kd)
+{
+    if (Ki != pid->Ki && Ki != 0.0f)
+        pid->integral *= pid->Ki / Ki;
+    pid->Kp = Kp;
+    pid->Ki = Ki;
+    pid->Kd = Kd;
+}
+
+/**
+ * @brief  增益调度：按工作点在增益表中线性插值，结果写入PID对象的Kp、Ki、Kd，
+ *      Ki变化时同时缩放积分值，积分项输出不跳变
+ * @param  pid PID参数结构体
+ * @param  Table 增益表，x递增
+ * @param  Num 增益表点数，至少为1
+ * @param  x 工作点，超出表的范围时取两端的值
+ * @param  Index 上次所在区间，从该区间开始查找，工作点变化缓慢时只需比较一两次；可为0
+ * @retval 无
+ */
+void PID_Schedule(PID *pid, const PID_GainPoint *Table, uint8_t Num, float x, uint8_t *Index)
+{
+    const PID_GainPoint *a, *b;
+    uint8_t i = Index ? *Index : 0;
+    float k;
+
+    if (Num < 2 || x <= Table[0].x)
+    {
+        a = &Table[0];
+        PID_SetGains(pid, a->Kp, a->Ki, a->Kd);
+        return;
+    }
+    if (x >= Table[Num - 1].x)
+    {
+        a = &Table[Num - 1];
+        PID_SetGains(pid, a->Kp, a->Ki, a->Kd);
+        return;
+    }
+
+    // 查找 Table[i].x <= x < Table[i + 1].x
+    if (i > Num - 2)
+        i = Num - 2;
+    while (i > 0 && x < Table[i].x)
+        i--;
+    while (x >= Table[i + 1].x)
+        i++;
+    if (Index)
+        *Index = i;
+
+    a = &Table[i];
+    b = &Table[i + 1];
+    k = (x - a->x) / (b->x - a->x);
+    PID_SetGains(pid, a->Kp + k * (b->Kp - a->Kp),
+                 a->Ki + k * (b->Ki - a->Ki),
+                 a->Kd + k * (b->Kd - a->Kd));
+}
+
+/**
+ * @brief  串级PID初始化，各级PID对象需已用PID_Init()初始化
+ * @param  cascade 串级运行状态
+ * @param  Stages 各级配置，由外到内，需在使用期间保持有效（一般定义为static const）
+ * @param  Num 级数
+ *      @arg 取值: 1 ~ PID_CASCADE_MAX
+ * @param  dt 节拍周期（s），即调用PID_Cascade_Update()的周期；为0时各级使用PID_Compute()
+ * @retval 无
+ */
+void PID_Cascade_Init(PID_Cascade *cascade, const PID_Stage *Stages, uint8_t Num, float dt)
+{
+    uint8_t i;
+
+    if (Num > PID_CASCADE_MAX)
+        Num = PID_CASCADE_MAX;
+    cascade->Stages = Stages;
+    cascade->Num = Num;
+    cascade->dt = dt;
+    for (i = 0; i < Num; i++)
+    {
+        cascade->Count[i] = 0; // 第一次调用时各级都运算
+        cascade->SchedIdx[i] = 0;
+        cascade->Output[i] = 0.0;
+    }
+}
+
+/**
+ * @brief  设置串级最外级的目标值
+ * @param  cascade 串级运行状态
+ * @param  target 目标值
+ * @retval 无
+ */
+void PID_Cascade_SetTarget(PID_Cascade *cascade, float target)
+{
+    PID_ResetTarget(cascade->Stages[0].pid, target);
+}
+
+/**
+ * @brief  串级PID运算，在控制节拍中每次调用。由外到内运算到期的各级，外级输出作为内级目标值
+ * @param  cascade 串级运行状态
+ * @param  input 各级测量值，input[i]对应Stages[i]
+ * @retval 最内级的输出（最内级本次未到运算时刻时为其上次输出）
+ */
+float PID_Cascade_Update(PID_Cascade *cascade, const float *input)
+{
+    const PID_Stage *s = cascade->Stages;
+    uint8_t i;
+
+    for (i = 0; i < cascade->Num; i++, s++)
+    {
+        if (cascade->Count[i])
+        {
+            cascade->Count[i]--;
+            continue;
+        }
+        cascade->Count[i] = s->Divider ? s->Divider - 1 : 0;
+
+        if (i > 0)
+            s->pid->target = cascade->Output[i - 1];
+        if (s->Sched)
+            PID_Schedule(s->pid, s->Sched, s->SchedNum, input[s->SchedBy], &cascade->SchedIdx[i]);
+
+        if (cascade->dt > 0.0f)
+            cascade->Output[i] = PID_Compute_dt(s->pid, input[i], cascade->dt * (s->Divider ? s->Divider : 1));
+        else
+            cascade->Output[i] = PID_Compute(s->pid, input[i]);
+    }
+    return cascade->Output[cascade->Num - 1];
+}
@@ -0,0 +1,100 @@
+#ifndef __PID_CASCADE_H
+#define __PID_CASCADE_H
+
+#include "stdint.h"
+#include "PID.h"
+
+/**
+ * 串级PID与增益调度。
+ * 串级：各级按由外到内的顺序排列（如 位置 -> 速度 -> 电流），外级输出作为内级目标值，最内级输出即为执行器输出。
+ *       每级有独立的分频系数，在同一个控制节拍中调用PID_Cascade_Update()，内级每个节拍运算、外级每N个节拍运算一次，
+ *       分频只是计数器递减，没有额外的函数调用。
+ * 增益调度：按工作点（如转速、负载）在增益表中线性插值得到Kp、Ki、Kd，工作点超出表的范围时取两端的值。
+ *           PID保存的是误差累积值（积分项 = Ki * integral），Ki改变时按比例缩放integral，积分项输出连续，不会因调度产生冲击。
+ * 增益表和各级配置均定义为const，存放在flash中，运行状态保存在PID_Cascade中。
+ */
+
+#define PID_CASCADE_MAX 4 // 最多级数
+
+// 增益表的一个点，同一个表中x必须递增
+typedef struct
+{
+    float x;          // 工作点
+    float Kp, Ki, Kd; // 该工作点的系数
+} PID_GainPoint;
+
+// 串级中一级的配置（const）
+typedef struct
+{
+    PID *pid;                   // 本级PID对象，需已用PID_Init()初始化限幅
+    uint8_t Divider;            // 分频系数，每Divider次PID_Cascade_Update()运算一次（1为每次都运算）
+    const PID_GainPoint *Sched; // 增益表，0为不做增益调度
+    uint8_t SchedNum;           // 增益表点数
+    uint8_t SchedBy;            // 工作点取PID_Cascade_Update()的input[SchedBy]
+} PID_Stage;
+
+// 串级运行状态
+typedef struct
+{
+    const PID_Stage *Stages;           // 各级配置，由外到内
+    uint8_t Num;                       // 级数
+    float dt;                          // 节拍周期（s），大于0时各级使用PID_Compute_dt()，为0时使用PID_Compute()
+    uint8_t Count[PID_CASCADE_MAX];    // 各级分频计数
+    uint8_t SchedIdx[PID_CASCADE_MAX]; // 各级增益表上次所在区间，加快查找
+    float Output[PID_CASCADE_MAX];     // 各级最近一次输出
+} PID_Cascade;
+
+void PID_Schedule(PID *pid, const PID_GainPoint *Table, uint8_t Num, float x, uint8_t *Index);
+void PID_Cascade_Init(PID_Cascade *cascade, const PID_Stage *Stages, uint8_t Num, float dt);
+void PID_Cascade_SetTarget(PID_Cascade *cascade, float target);
+float PID_Cascade_Update(PID_Cascade *cascade, const float *input);
+
+#endif /* __PID_CASCADE_H */
+
+/**
+  ***************************************************
+  * @example 位置-速度-电流三环串级例程
+  * @brief   CtrlTick为10kHz：电流环每个节拍运算，速度环1kHz，位置环100Hz；
+  *          电流环按转速做增益调度，速度越高比例系数越大
+  ***************************************************
+    PID PosPID, SpeedPID, CurPID;
+    PID_Cascade Servo;
+
+    static const PID_GainPoint CurGains[] = {
+        {0, 0.8, 200, 0},
+        {1000, 1.2, 300, 0},
+        {3000, 2.0, 450, 0},
+    };
+
+    static const PID_Stage ServoStages[] = {
+        {&PosPID, 100, 0, 0, 0},        // 100Hz
+        {&SpeedPID, 10, 0, 0, 0},       // 1kHz
+        {&CurPID, 1, CurGains, 3, 1},   // 10kHz，工作点为input[1]（转速）
+    };
+
+    static void ServoLoop(void *Arg, float dt)
+    {
+        float in[3];
+
+        in[0] = Encoder_GetPosition();
+        in[1] = Encoder_GetSpeed();
+        in[2] = ADC_GetCurrent();
+        TIM2_PWM_Duty(1, (uint8_t)PID_Cascade_Update((PID_Cascade *)Arg, in));
+    }
+
+    int main(void)
+    {
+        PID_Init(&PosPID, 2.0, 0, 0, 0, 0, 0, -3000, 3000);       // 输出为速度目标值
+        PID_Init(&SpeedPID, 0.01, 5.0, 0, 0, -2, 2, -2, 2);       // 输出为电流目标值
+        PID_Init(&CurPID, 0, 0, 0, 0, -100, 100, 0, 100);         // 系数由增益表设置
+        PID_Cascade_Init(&Servo, ServoStages, 3, CTRL_TICK_DT);
+        PID_Cascade_SetTarget(&Servo, 1000);                      // 位置目标值
+
+        CtrlTick_Register(ServoLoop, &Servo);
+        CtrlTick_Init();
+        while (1)
+        {
+        }
+    }
+  ***************************************************
+  */
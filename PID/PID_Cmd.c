@@ -0,0 +1,283 @@
+#include "PID_Cmd.h"
+#include "stddef.h"
+
+#define PID_FIELD_FLOAT 0 // float字段
+#define PID_FIELD_U8 1    // uint8_t字段（模式、标志），按浮点数读写，取值0 ~ Max的整数
+#define PID_FIELD_UNIT 2  // float字段，取值(0, 1]（滤波、跟踪系数）
+#define PID_FIELD_RO 0x80 // 只读，set返回错误
+
+// 字段名、其在结构体中的偏移、类型及uint8_t字段的最大值
+typedef struct
+{
+    const char *Name;
+    uint8_t Offset;
+    uint8_t Type;
+    uint8_t Max;
+} PID_Field;
+
+static const PID_Field PID_PosFields[] = {
+    {"Kp", offsetof(PID, Kp), PID_FIELD_FLOAT, 0},
+    {"Ki", offsetof(PID, Ki), PID_FIELD_FLOAT, 0},
+    {"Kd", offsetof(PID, Kd), PID_FIELD_FLOAT, 0},
+    {"target", offsetof(PID, target), PID_FIELD_FLOAT, 0},
+    {"error", offsetof(PID, error), PID_FIELD_FLOAT, 0},
+    {"last_error", offsetof(PID, last_error), PID_FIELD_FLOAT, 0},
+    {"integral", offsetof(PID, integral), PID_FIELD_FLOAT, 0},
+    {"maxIntegral", offsetof(PID, maxIntegral), PID_FIELD_FLOAT, 0},
+    {"minIntegral", offsetof(PID, minIntegral), PID_FIELD_FLOAT, 0},
+    {"maxOutput", offsetof(PID, maxOutput), PID_FIELD_FLOAT, 0},
+    {"minOutput", offsetof(PID, minOutput), PID_FIELD_FLOAT, 0},
+    {"dMode", offsetof(PID, dMode), PID_FIELD_U8, PID_D_ON_MEASUREMENT},
+    {"dReady", offsetof(PID, dReady), PID_FIELD_U8 | PID_FIELD_RO, 1},
+    {"dAlpha", offsetof(PID, dAlpha), PID_FIELD_UNIT, 0},
+    {"last_input", offsetof(PID, last_input), PID_FIELD_FLOAT, 0},
+    {"d_filtered", offsetof(PID, d_filtered), PID_FIELD_FLOAT, 0},
+    {"awMode", offsetof(PID, awMode), PID_FIELD_U8, PID_AW_BACK_CALC},
+    {"saturated", offsetof(PID, saturated), PID_FIELD_U8 | PID_FIELD_RO, PID_SAT_LOW},
+    {"Kt", offsetof(PID, Kt), PID_FIELD_UNIT, 0},
+};
+
+static const PID_Field PID_IncFields[] = {
+    {"Kp", offsetof(IncPID, Kp), PID_FIELD_FLOAT, 0},
+    {"Ki", offsetof(IncPID, Ki), PID_FIELD_FLOAT, 0},
+    {"Kd", offsetof(IncPID, Kd), PID_FIELD_FLOAT, 0},
+    {"target", offsetof(IncPID, target), PID_FIELD_FLOAT, 0},
+    {"error", offsetof(IncPID, error), PID_FIELD_FLOAT, 0},
+    {"last_error", offsetof(IncPID, last_error), PID_FIELD_FLOAT, 0},
+    {"prev_error", offsetof(IncPID, prev_error), PID_FIELD_FLOAT, 0},
+    {"maxOutput", offsetof(IncPID, maxOutput), PID_FIELD_FLOAT, 0},
+    {"minOutput", offsetof(IncPID, minOutput), PID_FIELD_FLOAT, 0},
+    {"IncPID_Output", offsetof(IncPID, IncPID_Output), PID_FIELD_FLOAT, 0},
+};
+
+static const PID_CmdObj *PID_CmdObjs; // 已绑定的对象
+static uint8_t PID_CmdObjNum;
+
+/**
+ * @brief  比较两个字符串是否相同（不区分大小写）。
+ * @param  a 字符串。
+ * @param  b 字符串。
+ * @retval 1: 相同，0: 不同
+ */
+static uint8_t PID_Cmd_NameEqual(const char *a, const char *b)
+{
+    char ca, cb;
+
+    do
+    {
+        ca = *a++;
+        cb = *b++;
+        if (ca >= 'A' && ca <= 'Z')
+            ca += 'a' - 'A';
+        if (cb >= 'A' && cb <= 'Z')
+            cb += 'a' - 'A';
+    } while (ca && ca == cb);
+    return (ca == cb);
+}
+
+/**
+ * @brief  绑定可通过命令访问的PID对象。
+ * @param  Objs 对象表，需在使用期间保持有效（一般定义为static const）。
+ * @param  Num 对象个数。
+ * @retval 无
+ */
+void PID_Cmd_Bind(const PID_CmdObj *Objs, uint8_t Num)
+{
+    PID_CmdObjs = Objs;
+    PID_CmdObjNum = Num;
+}
+
+/**
+ * @brief  按名称查找对象。
+ * @param  Name 对象名。
+ * @retval 对象，不存在时返回0
+ */
+static const PID_CmdObj *PID_Cmd_FindObj(const char *Name)
+{
+    uint8_t i;
+
+    for (i = 0; i < PID_CmdObjNum; i++)
+    {
+        if (PID_Cmd_NameEqual(PID_CmdObjs[i].Name, Name))
+            return &PID_CmdObjs[i];
+    }
+    return 0;
+}
+
+/**
+ * @brief  获取对象对应的字段表。
+ * @param  Obj 对象。
+ * @param  Num 字段个数。
+ * @retval 字段表
+ */
+static const PID_Field *PID_Cmd_Fields(const PID_CmdObj *Obj, uint8_t *Num)
+{
+    if (Obj->Kind == PID_CMD_INC)
+    {
+        *Num = sizeof(PID_IncFields) / sizeof(PID_IncFields[0]);
+        return PID_IncFields;
+    }
+    *Num = sizeof(PID_PosFields) / sizeof(PID_PosFields[0]);
+    return PID_PosFields;
+}
+
+/**
+ * @brief  按名称查找字段。
+ * @param  Obj 对象。
+ * @param  Name 字段名。
+ * @retval 字段，不存在时返回0
+ */
+static const PID_Field *PID_Cmd_FindField(const PID_CmdObj *Obj, const char *Name)
+{
+    const PID_Field *fields;
+    uint8_t i, num;
+
+    fields = PID_Cmd_Fields(Obj, &num);
+    for (i = 0; i < num; i++)
+    {
+        if (PID_Cmd_NameEqual(fields[i].Name, Name))
+            return &fields[i];
+    }
+    return 0;
+}
+
+/**
+ * @brief  读取字段值。
+ * @param  Obj 对象。
+ * @param  Field 字段。
+ * @retval 字段值
+ */
+static float PID_Cmd_Read(const PID_CmdObj *Obj, const PID_Field *Field)
+{
+    uint8_t *addr = (uint8_t *)Obj->Obj + Field->Offset;
+
+    if (Field->Type & PID_FIELD_U8)
+        return *addr;
+    return *(float *)addr;
+}
+
+/**
+ * @brief  检查并写入字段值，超出取值范围时不修改字段。
+ * @param  Obj 对象。
+ * @param  Field 字段。
+ * @param  Value 新值。
+ * @param  Print 输出函数，用于说明错误原因。
+ * @retval CMD_OK、CMD_ERR_ARG（超出取值范围）或CMD_ERR_FAIL（只读字段）
+ */
+static uint8_t PID_Cmd_Write(const PID_CmdObj *Obj, const PID_Field *Field, float Value, Cmd_PrintFunc Print)
+{
+    uint8_t *addr = (uint8_t *)Obj->Obj + Field->Offset;
+
+    if (Field->Type & PID_FIELD_RO)
+    {
+        Print("ERROR: %s is read-only\n", Field->Name);
+        return CMD_ERR_FAIL;
+    }
+    if (Field->Type & PID_FIELD_U8)
+    {
+        // 先判断范围再转换，超出范围的浮点数转换为整数是未定义行为
+        if (!(Value >= 0 && Value <= Field->Max) || Value != (uint8_t)Value)
+        {
+            Print("ERROR: %s must be an integer 0 ~ %d\n", Field->Name, Field->Max);
+            return CMD_ERR_ARG;
+        }
+        *addr = (uint8_t)Value;
+    }
+    else if (Field->Type == PID_FIELD_UNIT)
+    {
+        if (!(Value > 0 && Value <= 1))
+        {
+            Print("ERROR: %s must be in (0, 1]\n", Field->Name);
+            return CMD_ERR_ARG;
+        }
+        *(float *)addr = Value;
+    }
+    else
+        *(float *)addr = Value;
+    return CMD_OK;
+}
+
+/**
+ * @brief  get命令：get <对象> [字段]
+ * @param  Args Argc Print 见command.h中Cmd_Handler的说明。
+ * @retval CMD_OK或CMD_ERR_FAIL（对象或字段不存在）
+ */
+static uint8_t PID_Cmd_Get(const Cmd_Arg *Args, uint8_t Argc, Cmd_PrintFunc Print)
+{
+    const PID_CmdObj *obj = PID_Cmd_FindObj(Args[0].s);
+    const PID_Field *fields, *field;
+    uint8_t i, num;
+
+    if (obj == 0)
+        return CMD_ERR_FAIL;
+
+    if (Argc > 1)
+    {
+        field = PID_Cmd_FindField(obj, Args[1].s);
+        if (field == 0)
+            return CMD_ERR_FAIL;
+        Print("%s.%s=%.4f\n", obj->Name, field->Name, PID_Cmd_Read(obj, field));
+        return CMD_OK;
+    }
+
+    fields = PID_Cmd_Fields(obj, &num);
+    for (i = 0; i < num; i++)
+        Print("%s.%s=%.4f\n", obj->Name, fields[i].Name, PID_Cmd_Read(obj, &fields[i]));
+    return CMD_OK;
+}
+
+/**
+ * @brief  set命令：set <对象> <字段> <值>
+ *      dMode、awMode只接受对应宏定义的取值，dAlpha、Kt取值(0, 1]，saturated、dReady只读。
+ * @param  Args Argc Print 见command.h中Cmd_Handler的说明。
+ * @retval CMD_OK、CMD_ERR_ARG（值超出范围）或CMD_ERR_FAIL（对象或字段不存在、字段只读）
+ */
+static uint8_t PID_Cmd_Set(const Cmd_Arg *Args, uint8_t Argc, Cmd_PrintFunc Print)
+{
+    const PID_CmdObj *obj = PID_Cmd_FindObj(Args[0].s);
+    const PID_Field *field;
+    uint8_t ret;
+
+    (void)Argc;
+    if (obj == 0)
+        return CMD_ERR_FAIL;
+    field = PID_Cmd_FindField(obj, Args[1].s);
+    if (field == 0)
+        return CMD_ERR_FAIL;
+
+    ret = PID_Cmd_Write(obj, field, Args[2].f, Print);
+    if (ret != CMD_OK)
+        return ret;
+    Print("OK\n");
+    return CMD_OK;
+}
+
+/**
+ * @brief  list命令：输出已绑定的对象及字段名
+ * @param  Args Argc Print 见command.h中Cmd_Handler的说明。
+ * @retval CMD_OK
+ */
+static uint8_t PID_Cmd_List(const Cmd_Arg *Args, uint8_t Argc, Cmd_PrintFunc Print)
+{
+    const PID_Field *fields;
+    uint8_t i, j, num;
+
+    (void)Args;
+    (void)Argc;
+
+    for (i = 0; i < PID_CmdObjNum; i++)
+    {
+        Print("%s:", PID_CmdObjs[i].Name);
+        fields = PID_Cmd_Fields(&PID_CmdObjs[i], &num);
+        for (j = 0; j < num; j++)
+            Print(" %s", fields[j].Name);
+        Print("\n");
+    }
+    return CMD_OK;
+}
+
+const Cmd_Entry PID_CmdTable[PID_CMD_NUM] = {
+    {"get", "sS", PID_Cmd_Get, "get <obj> [field]"},
+    {"set", "ssf", PID_Cmd_Set, "set <obj> <field> <value>"},
+    {"list", "", PID_Cmd_List, "list"},
+};
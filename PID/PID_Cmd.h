@@ -0,0 +1,62 @@
+#ifndef __PID_CMD_H
+#define __PID_CMD_H
+
+#include "PID.h"
+#include "command.h"
+
+/**
+ * PID参数串口调节命令（基于command.h的命令解析器）。
+ *   get <对象>            输出对象的全部字段
+ *   get <对象> <字段>     输出一个字段
+ *   set <对象> <字段> <值> 修改一个字段
+ *   list                  输出已绑定的对象及字段名
+ * 对象名和字段名不区分大小写，字段名与结构体成员名相同（如 Kp、target、maxIntegral）。
+ * set检查取值范围（与PID_SetDerivative/PID_SetAntiWindup相同）：dMode、awMode只接受对应宏定义的整数值，
+ * dAlpha、Kt取值(0, 1]，saturated、dReady只读；超出范围时输出错误原因且不修改字段。
+ */
+
+#define PID_CMD_POS 0 // 位置式PID（PID）
+#define PID_CMD_INC 1 // 增量式PID（IncPID）
+
+// 可通过命令访问的PID对象
+typedef struct
+{
+    const char *Name; // 对象名
+    void *Obj;        // 指向PID或IncPID结构体
+    uint8_t Kind;     // PID_CMD_POS 或 PID_CMD_INC
+} PID_CmdObj;
+
+extern const Cmd_Entry PID_CmdTable[]; // get/set/list命令表
+#define PID_CMD_NUM 3                  // PID_CmdTable的表项数
+
+void PID_Cmd_Bind(const PID_CmdObj *Objs, uint8_t Num); // 绑定可通过命令访问的PID对象。
+
+#endif /* __PID_CMD_H */
+
+/**
+  ***************************************************
+  * @example PID参数串口调节例程
+  * @brief   通过串口发送 "set motor Kp 0.015"、"get motor" 等命令调节和查看PID参数
+  ***************************************************
+    PID MotorPID;
+    IncPID ServoPID;
+
+    static const PID_CmdObj PidObjs[] = {
+        {"motor", &MotorPID, PID_CMD_POS},
+        {"servo", &ServoPID, PID_CMD_INC},
+    };
+
+    PID_Init(&MotorPID, 0.015, 0.014, 0.001, 370, -1850, 1850, 0, 100);
+    IncPID_Init(&ServoPID, 0.05, 0, 0.01, 70, 4.5, 9.5);
+    PID_Cmd_Bind(PidObjs, 2);
+
+    while (1)
+    {
+        if (get_UART_RecStatus())
+        {
+            Cmd_Exec(PID_CmdTable, PID_CMD_NUM, (char *)USART_RX_BUF, UART_printf);
+            Reset_UART_RecStatus();
+        }
+    }
+  ***************************************************
+  */
@@ -0,0 +1,230 @@
+#include "PID_q.h"
+
+#if PID_Q_FRAC < 16 || PID_Q_FRAC > 24
+#error "PID_Q_FRAC must be between 16 and 24! See PID_q.h file."
+#endif
+
+/**
+ * @brief  系数与Q15数据相乘，结果为Q31（即Q15左移16位）。
+ * @param  K 系数，Q(PID_Q_FRAC)格式。
+ * @param  x 数据，Q15格式（可超出int16_t范围）。
+ * @retval 乘积，64位，不会溢出
+ */
+static int64_t PID_Q_Mul(int32_t K, int32_t x)
+{
+    return ((int64_t)K * x) >> (PID_Q_FRAC - 16); // SMULL
+}
+
+/**
+ * @brief  将Q31结果截取到[min, max]（Q15）范围内。
+ * @param  x 要截取的数，Q31格式。
+ * @param  min 最小值，Q15格式。
+ * @param  max 最大值，Q15格式。
+ * @retval 截取后的值，Q31格式
+ */
+static int64_t PID_Q_Clamp(int64_t x, q15_t min, q15_t max)
+{
+    if (x > (int64_t)max * 65536) // 负数左移是未定义行为，用乘法（编译为移位）
+        return (int64_t)max * 65536;
+    if (x < (int64_t)min * 65536)
+        return (int64_t)min * 65536;
+    return x;
+}
+
+/**
+ * @brief  位置式定点数PID参数初始化
+ * @param  pid PID参数结构体
+ * @param  Kp 比例项系数，Q(PID_Q_FRAC)格式，可用PID_Q_GAIN()转换
+ * @param  Ki 积分项系数
+ * @param  Kd 微分项系数
+ * @param  target 目标值，Q15格式，可用PID_Q15()转换
+ * @param  minIntegral 积分限幅-最小值
+ * @param  maxIntegral 积分限幅-最大值
+ * @param  minOutput PID输出限幅-最小值
+ * @param  maxOutput PID输出限幅-最大值
+ * @retval 无
+ */
+void PID_q_Init(PID_q *pid, int32_t Kp, int32_t Ki, int32_t Kd, q15_t target,
+                q15_t minIntegral, q15_t maxIntegral,
+                q15_t minOutput, q15_t maxOutput)
+{
+    pid->Kp = Kp;
+    pid->Ki = Ki;
+    pid->Kd = Kd;
+    pid->target = target;
+    pid->minIntegral = minIntegral;
+    pid->maxIntegral = maxIntegral;
+    pid->minOutput = minOutput;
+    pid->maxOutput = maxOutput;
+    pid->error = 0;
+    pid->last_error = 0;
+    pid->integral = 0;
+}
+
+/**
+ * @brief  重设位置式定点数PID目标值
+ * @param  pid PID参数结构体
+ * @param  target 目标值，Q15格式
+ * @retval 无
+ */
+void PID_q_ResetTarget(PID_q *pid, q15_t target)
+{
+    pid->target = target;
+}
+
+/**
+ * @brief  重设位置式定点数PID各项系数
+ * @param  pid PID参数结构体
+ * @param  K_x 要修改的系数
+ *      @arg 有效取值:
+ *          - \b K_p : p项系数
+ *          - \b K_i : i项系数
+ *          - \b K_d : d项系数
+ * @param  value 系数的新值，Q(PID_Q_FRAC)格式
+ * @retval 无
+ */
+void PID_q_Reset_pid(PID_q *pid, uint8_t K_x, int32_t value)
+{
+    switch (K_x)
+    {
+    case K_p:
+        pid->Kp = value;
+        break;
+    case K_i:
+        pid->Ki = value;
+        break;
+    case K_d:
+        pid->Kd = value;
+        break;
+    }
+}
+
+/**
+ * @brief  位置式定点数PID运算。
+ * @param  pid PID参数结构体
+ * @param  input 当前值，Q15格式
+ * @retval 位置式PID运算结果，Q15格式
+ */
+q15_t PID_q_Compute(PID_q *pid, q15_t input)
+{
+    int64_t p_term, i_term, d_term, PID_Output;
+
+    pid->error = (int32_t)pid->target - input; // 计算误差（-2.0 ~ 2.0，不截取，与浮点版本一致）
+
+    // 累积误差（饱和累加，先判断是否越界再相加，避免有符号溢出）
+    if (pid->error > 0 && pid->integral > INT32_MAX - pid->error)
+        pid->integral = INT32_MAX;
+    else if (pid->error < 0 && pid->integral < INT32_MIN - pid->error)
+        pid->integral = INT32_MIN;
+    else
+        pid->integral += pid->error;
+
+    p_term = PID_Q_Mul(pid->Kp, pid->error);                            // 比例项
+    i_term = PID_Q_Mul(pid->Ki, pid->integral);                         // 积分项
+    d_term = PID_Q_Mul(pid->Kd, pid->error - pid->last_error);          // 微分项
+
+    // 积分限幅
+    i_term = PID_Q_Clamp(i_term, pid->minIntegral, pid->maxIntegral);
+
+    // 更新上次误差
+    pid->last_error = pid->error;
+
+    PID_Output = p_term + i_term + d_term;
+
+    // PID输出限幅，四舍五入为Q15
+    PID_Output = PID_Q_Clamp(PID_Output, pid->minOutput, pid->maxOutput);
+    return (q15_t)((PID_Output + 0x8000) >> 16);
+}
+
+/**
+ * @brief  增量式定点数PID参数初始化
+ * @param  incpid PID参数结构体
+ * @param  Kp 比例项系数，Q(PID_Q_FRAC)格式，可用PID_Q_GAIN()转换
+ * @param  Ki 积分项系数
+ * @param  Kd 微分项系数
+ * @param  target 目标值，Q15格式，可用PID_Q15()转换
+ * @param  minOutput PID输出限幅-最小值
+ * @param  maxOutput PID输出限幅-最大值
+ * @retval 无
+ */
+void IncPID_q_Init(IncPID_q *incpid, int32_t Kp, int32_t Ki, int32_t Kd, q15_t target,
+                   q15_t minOutput, q15_t maxOutput)
+{
+    incpid->Kp = Kp;
+    incpid->Ki = Ki;
+    incpid->Kd = Kd;
+    incpid->target = target;
+    incpid->minOutput = minOutput;
+    incpid->maxOutput = maxOutput;
+    incpid->error = 0;
+    incpid->last_error = 0;
+    incpid->prev_error = 0;
+    incpid->IncPID_Output = 0;
+}
+
+/**
+ * @brief  重设增量式定点数PID目标值
+ * @param  incpid PID参数结构体
+ * @param  target 目标值，Q15格式
+ * @retval 无
+ */
+void IncPID_q_ResetTarget(IncPID_q *incpid, q15_t target)
+{
+    incpid->target = target;
+}
+
+/**
+ * @brief  重设增量式定点数PID各项系数
+ * @param  incpid PID参数结构体
+ * @param  K_x 要修改的系数
+ *      @arg 有效取值:
+ *          - \b K_p : p项系数
+ *          - \b K_i : i项系数
+ *          - \b K_d : d项系数
+ * @param  value 系数的新值，Q(PID_Q_FRAC)格式
+ * @retval 无
+ */
+void IncPID_q_Reset_pid(IncPID_q *incpid, uint8_t K_x, int32_t value)
+{
+    switch (K_x)
+    {
+    case K_p:
+        incpid->Kp = value;
+        break;
+    case K_i:
+        incpid->Ki = value;
+        break;
+    case K_d:
+        incpid->Kd = value;
+        break;
+    }
+}
+
+/**
+ * @brief  增量式定点数PID运算。
+ * @param  incpid PID参数结构体
+ * @param  input 当前值，Q15格式
+ * @retval 增量式PID运算结果，Q15格式（incpid->IncPID_Output的高16位，四舍五入）
+ */
+q15_t IncPID_q_Compute(IncPID_q *incpid, q15_t input)
+{
+    int64_t p_term, i_term, d_term, output;
+
+    incpid->error = (int32_t)incpid->target - input;
+
+    p_term = PID_Q_Mul(incpid->Kp, incpid->error - incpid->last_error);                            // 比例项
+    i_term = PID_Q_Mul(incpid->Ki, incpid->error);                                                 // 积分项
+    d_term = PID_Q_Mul(incpid->Kd, incpid->error - 2 * incpid->last_error + incpid->prev_error); // 微分项
+
+    // 更新误差
+    incpid->prev_error = incpid->last_error;
+    incpid->last_error = incpid->error;
+
+    // 以Q31累加，增量的舍入误差不会随运算次数累积
+    output = incpid->IncPID_Output + p_term + i_term + d_term;
+
+    // PID输出限幅
+    incpid->IncPID_Output = (q31_t)PID_Q_Clamp(output, incpid->minOutput, incpid->maxOutput);
+
+    return (q15_t)(((int64_t)incpid->IncPID_Output + 0x8000) >> 16);
+}
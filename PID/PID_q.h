@@ -0,0 +1,113 @@
+#ifndef __PID_Q_H
+#define __PID_Q_H
+
+#include "stdint.h"
+#include "PID.h" // K_p、K_i、K_d
+
+/**
+ * 定点数PID（位置式PID_q、增量式IncPID_q），运算过程与PID.c中的浮点版本相同，只使用整数乘加和饱和运算。
+ * 数据格式：
+ *   - 目标值、输入值、限幅值、输出值：Q15（int16_t，-1.0 ~ 0.99997，对应传感器/执行器满量程）
+ *   - 偏差：Q15数值存放在int32_t中（目标值 - 输入值，-2.0 ~ 2.0），不截取，与浮点版本的结果一致
+ *   - 系数Kp、Ki、Kd：Q(PID_Q_FRAC)（int32_t，默认Q15.16，范围 -32768.0 ~ 32767.99998，分辨率1.5e-5）
+ *   - 积分值：Q15偏差的饱和累加（int32_t）
+ *   - 中间结果：系数与Q15相乘得到Q31（64位乘积，不会溢出），三项在64位中相加后按限幅值截取，再四舍五入为Q15输出
+ *   - 增量式PID的输出累加值IncPID_Output：Q31，高16位即Q15输出，增量的舍入误差不会累积
+ * 与浮点版本的一致性测试见PID/Host/pid_q_equiv.c（在电脑上编译运行）。
+ */
+#define PID_Q_FRAC 16 // 系数的小数位数（16 ~ 24，越大系数分辨率越高、范围越小）
+
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+
+#define PID_Q15(x) ((q15_t)((x) * 32768.0f))                   // 浮点常数转换为Q15（|x| < 1）
+#define PID_Q_GAIN(x) ((int32_t)((x) * (float)(1UL << PID_Q_FRAC))) // 浮点常数转换为系数格式
+#define PID_Q15_TO_FLOAT(x) ((float)(x) / 32768.0f)            // Q15转换为浮点数
+
+/**************************** 位置式PID ****************************/
+
+typedef struct
+{
+    int32_t Kp, Ki, Kd;             // 比例、积分、微分系数
+    q15_t target;                   // 目标值
+    int32_t error;                  // 偏差值（Q15，-2.0 ~ 2.0）
+    int32_t last_error;             // 前一次偏差
+    q31_t integral;                 // 积分值
+    q15_t maxIntegral, minIntegral; // 积分限幅
+    q15_t maxOutput, minOutput;     // 输出限幅
+} PID_q;
+
+void PID_q_Init(PID_q *pid, int32_t Kp, int32_t Ki, int32_t Kd, q15_t target,
+                q15_t minIntegral, q15_t maxIntegral,
+                q15_t minOutput, q15_t maxOutput);
+void PID_q_ResetTarget(PID_q *pid, q15_t target);
+void PID_q_Reset_pid(PID_q *pid, uint8_t Kx, int32_t coefficient);
+q15_t PID_q_Compute(PID_q *pid, q15_t input);
+
+/******************************************************************/
+
+/**************************** 增量式PID ****************************/
+
+typedef struct
+{
+    int32_t Kp, Ki, Kd;         // 比例、积分、微分系数
+    q15_t target;               // 目标值
+    int32_t error;              // 偏差值（Q15，-2.0 ~ 2.0）
+    int32_t last_error;         // 前一次偏差
+    int32_t prev_error;         // 前两次偏差
+    q15_t maxOutput, minOutput; // 输出限幅
+    q31_t IncPID_Output;        // PID运算结果（Q31）
+} IncPID_q;
+
+void IncPID_q_Init(IncPID_q *incpid, int32_t Kp, int32_t Ki, int32_t Kd, q15_t target,
+                   q15_t minOutput, q15_t maxOutput);
+void IncPID_q_ResetTarget(IncPID_q *incpid, q15_t target);
+void IncPID_q_Reset_pid(IncPID_q *incpid, uint8_t Kx, int32_t coefficient);
+q15_t IncPID_q_Compute(IncPID_q *incpid, q15_t input);
+
+/******************************************************************/
+
+#endif /* __PID_Q_H */
+
+/**
+  ***************************************************
+  * @example 定点数PID例程
+  * @brief   电机转速满量程为2000，转换为Q15后运算
+  ***************************************************
+    PID_q MotorPID;
+    q15_t out;
+
+    PID_q_Init(&MotorPID, PID_Q_GAIN(0.8), PID_Q_GAIN(0.05), PID_Q_GAIN(0.1),
+               PID_Q15(370.0 / 2000), PID_Q15(-0.9), PID_Q15(0.9), 0, PID_Q15(0.5));
+
+    out = PID_q_Compute(&MotorPID, (q15_t)(speed * 32768 / 2000)); // speed: 当前转速
+    PWM_SetCompare(out * 1000 / 32768);                          // out: 0 ~ 0.5
+  ***************************************************
+  */
+
+/**
+  ***************************************************
+  * @example 定点数与浮点数PID的耗时对比例程
+  * @brief   用Delay_Cycles()（delay.h）测量一次运算消耗的CPU周期数
+  ***************************************************
+    PID f;
+    PID_q q;
+    volatile float fin = 0.25f;
+    volatile q15_t qin = PID_Q15(0.25);
+    uint32_t t0, t1, cycles_float, cycles_q;
+
+    PID_Init(&f, 0.8f, 0.05f, 0.1f, 0.3f, -0.9f, 0.9f, -0.5f, 0.5f);
+    PID_q_Init(&q, PID_Q_GAIN(0.8), PID_Q_GAIN(0.05), PID_Q_GAIN(0.1),
+               PID_Q15(0.3), PID_Q15(-0.9), PID_Q15(0.9), PID_Q15(-0.5), PID_Q15(0.5));
+
+    t0 = Delay_Cycles();
+    PID_Compute(&f, fin);
+    t1 = Delay_Cycles();
+    cycles_float = t1 - t0;
+
+    t0 = Delay_Cycles();
+    PID_q_Compute(&q, qin);
+    t1 = Delay_Cycles();
+    cycles_q = t1 - t0;
+  ***************************************************
+  */
@@ -0,0 +1,274 @@
+#include "command.h"
+
+/**
+ * @brief  判断字符是否为分隔符。
+ * @param  c 字符。
+ * @retval 1: 空格或制表符，0: 其他
+ */
+static uint8_t Cmd_IsSpace(char c)
+{
+    return (c == ' ' || c == '\t');
+}
+
+/**
+ * @brief  比较两个字符串是否相同。
+ * @param  a 字符串。
+ * @param  b 字符串。
+ * @retval 1: 相同，0: 不同
+ */
+static uint8_t Cmd_StrEqual(const char *a, const char *b)
+{
+    while (*a && *a == *b)
+    {
+        a++;
+        b++;
+    }
+    return (*a == *b);
+}
+
+/**
+ * @brief  将字符串转换为整数，整个字符串都必须是合法的数字。
+ * @param  Str 字符串，格式：[+|-]十进制数字 或 [+|-]0x十六进制数字。
+ * @param  Value 转换结果。
+ * @retval 状态值
+ *      - \b 1 : 转换成功
+ *      - \b 0 : 格式错误或超出int32_t范围
+ */
+uint8_t Cmd_ParseInt(const char *Str, int32_t *Value)
+{
+    uint32_t v = 0, limit;
+    uint8_t neg = 0, radix = 10, d;
+    const char *start;
+
+    if (*Str == '+' || *Str == '-')
+        neg = (*Str++ == '-');
+    if (Str[0] == '0' && (Str[1] == 'x' || Str[1] == 'X'))
+    {
+        radix = 16;
+        Str += 2;
+    }
+    limit = neg ? 0x80000000UL : 0x7FFFFFFFUL;
+
+    for (start = Str; *Str; Str++)
+    {
+        if (*Str >= '0' && *Str <= '9')
+            d = *Str - '0';
+        else if (radix == 16 && *Str >= 'a' && *Str <= 'f')
+            d = *Str - 'a' + 10;
+        else if (radix == 16 && *Str >= 'A' && *Str <= 'F')
+            d = *Str - 'A' + 10;
+        else
+            return 0;
+        if (v > (limit - d) / radix)
+            return 0;
+        v = v * radix + d;
+    }
+    if (Str == start)
+        return 0;
+
+    *Value = neg ? (int32_t)(0U - v) : (int32_t)v;
+    return 1;
+}
+
+/**
+ * @brief  将字符串转换为浮点数，整个字符串都必须是合法的数字。
+ *      有效数字超过9位时多余的数字只计入数量级，精度与float一致。
+ * @param  Str 字符串，格式：[+|-]数字[.数字][e|E[+|-]数字]，如 1.5、-.25、3e-2。
+ * @param  Value 转换结果。
+ * @retval 状态值
+ *      - \b 1 : 转换成功
+ *      - \b 0 : 格式错误
+ */
+uint8_t Cmd_ParseFloat(const char *Str, float *Value)
+{
+    static const float pow10[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f};
+    uint32_t mant = 0;
+    int16_t exp10 = 0, e = 0;
+    uint8_t neg = 0, eneg = 0, digits = 0, ndig = 0;
+    float v;
+
+    if (*Str == '+' || *Str == '-')
+        neg = (*Str++ == '-');
+
+    // 整数部分
+    for (; *Str >= '0' && *Str <= '9'; Str++, ndig++)
+    {
+        if (digits < 9)
+        {
+            mant = mant * 10 + (*Str - '0');
+            if (mant)
+                digits++;
+        }
+        else
+        {
+            exp10++;
+        }
+    }
+
+    // 小数部分
+    if (*Str == '.')
+    {
+        for (Str++; *Str >= '0' && *Str <= '9'; Str++, ndig++)
+        {
+            if (digits < 9)
+            {
+                mant = mant * 10 + (*Str - '0');
+                if (mant)
+                    digits++;
+                exp10--;
+            }
+        }
+    }
+    if (ndig == 0)
+        return 0;
+
+    // 指数部分
+    if (*Str == 'e' || *Str == 'E')
+    {
+        Str++;
+        if (*Str == '+' || *Str == '-')
+            eneg = (*Str++ == '-');
+        if (*Str < '0' || *Str > '9')
+            return 0;
+        for (; *Str >= '0' && *Str <= '9'; Str++)
+        {
+            if (e < 1000)
+                e = e * 10 + (*Str - '0');
+        }
+        exp10 += eneg ? -e : e;
+    }
+    if (*Str)
+        return 0;
+
+    v = (float)mant;
+    for (; exp10 >= 9; exp10 -= 9)
+        v *= pow10[9];
+    for (; exp10 <= -9; exp10 += 9)
+        v /= pow10[9];
+    if (exp10 > 0)
+        v *= pow10[exp10];
+    else if (exp10 < 0)
+        v /= pow10[-exp10];
+
+    *Value = neg ? -v : v;
+    return 1;
+}
+
+/**
+ * @brief  不输出任何内容（调用Cmd_Exec()时Print为0的情况下使用）。
+ * @param  Fmt 格式字符串。
+ * @retval 0
+ */
+static int Cmd_NoPrint(const char *Fmt, ...)
+{
+    (void)Fmt;
+    return 0;
+}
+
+/**
+ * @brief  解析并执行一行命令。Line中的分隔符会被改写为'\0'。
+ * @param  Table 命令表。
+ * @param  Num 命令表项数。
+ * @param  Line 一行命令，以'\0'结尾。
+ * @param  Print 输出函数，用于输出命令结果和错误信息，为0时不输出。
+ * @retval CMD_OK或错误码；空行返回CMD_OK。
+ */
+uint8_t Cmd_Exec(const Cmd_Entry *Table, uint8_t Num, char *Line, Cmd_PrintFunc Print)
+{
+    char *tok[CMD_ARGS_MAX + 1];
+    Cmd_Arg args[CMD_ARGS_MAX];
+    const Cmd_Entry *cmd = 0;
+    const char *type;
+    uint8_t ntok = 0, i, ok, ret;
+
+    if (Print == 0)
+        Print = Cmd_NoPrint;
+
+    // 按空白分隔，原地切分
+    while (*Line)
+    {
+        while (Cmd_IsSpace(*Line))
+            *Line++ = '\0';
+        if (*Line == '\0')
+            break;
+        if (ntok > CMD_ARGS_MAX)
+        {
+            Print("ERROR: too many arguments\n");
+            return CMD_ERR_ARGC;
+        }
+        tok[ntok++] = Line;
+        while (*Line && !Cmd_IsSpace(*Line))
+            Line++;
+    }
+    if (ntok == 0)
+        return CMD_OK;
+
+    for (i = 0; i < Num; i++)
+    {
+        if (Cmd_StrEqual(Table[i].Name, tok[0]))
+        {
+            cmd = &Table[i];
+            break;
+        }
+    }
+    if (cmd == 0)
+    {
+        Print("ERROR: unknown command '%s'\n", tok[0]);
+        return CMD_ERR_UNKNOWN;
+    }
+
+    // 按登记的类型转换参数
+    type = cmd->Args ? cmd->Args : "";
+    for (i = 0; i < ntok - 1; i++)
+    {
+        switch (type[i])
+        {
+        case 'i':
+        case 'I':
+            ok = Cmd_ParseInt(tok[i + 1], &args[i].i);
+            break;
+        case 'f':
+        case 'F':
+            ok = Cmd_ParseFloat(tok[i + 1], &args[i].f);
+            break;
+        case 's':
+        case 'S':
+            args[i].s = tok[i + 1];
+            ok = 1;
+            break;
+        default: // 参数过多
+            Print("ERROR: usage: %s\n", cmd->Help);
+            return CMD_ERR_ARGC;
+        }
+        if (!ok)
+        {
+            Print("ERROR: bad argument '%s'\n", tok[i + 1]);
+            return CMD_ERR_ARG;
+        }
+    }
+    if (type[i] >= 'a' && type[i] <= 'z') // 缺少必需参数
+    {
+        Print("ERROR: usage: %s\n", cmd->Help);
+        return CMD_ERR_ARGC;
+    }
+
+    ret = cmd->Handler(args, ntok - 1, Print);
+    if (ret != CMD_OK)
+        Print("ERROR: %s failed\n", cmd->Name);
+    return ret;
+}
+
+/**
+ * @brief  输出命令列表及帮助信息。
+ * @param  Table 命令表。
+ * @param  Num 命令表项数。
+ * @param  Print 输出函数。
+ * @retval 无
+ */
+void Cmd_PrintHelp(const Cmd_Entry *Table, uint8_t Num, Cmd_PrintFunc Print)
+{
+    uint8_t i;
+
+    for (i = 0; i < Num; i++)
+        Print("%s\n", Table[i].Help ? Table[i].Help : Table[i].Name);
+}
@@ -0,0 +1,92 @@
+#ifndef __COMMAND_H
+#define __COMMAND_H
+
+#include "stdint.h"
+
+/**
+ * 表驱动的文本命令解析器，不使用sscanf/堆。
+ * 一行命令由空格或制表符分隔：命令名 参数1 参数2 ...
+ * 每条命令在Cmd_Entry中登记参数类型，解析成功后才调用处理函数。
+ */
+#define CMD_ARGS_MAX 6 // 一条命令最多的参数个数
+
+/**
+ * 参数类型（Cmd_Entry.Args中的字符，依次对应每个参数）：
+ *   'i' 整数（十进制或0x开头的十六进制），'f' 浮点数（支持小数和e指数），'s' 字符串
+ *   大写字母'I' 'F' 'S'表示可省略的参数，只能放在必需参数之后
+ */
+
+// 返回值
+#define CMD_OK 0          // 执行成功
+#define CMD_ERR_UNKNOWN 1 // 未知命令
+#define CMD_ERR_ARGC 2    // 参数个数错误
+#define CMD_ERR_ARG 3     // 参数格式错误
+#define CMD_ERR_FAIL 4    // 处理函数执行失败（如字段名不存在）
+
+// 解析后的参数
+typedef union
+{
+    int32_t i;
+    float f;
+    const char *s;
+} Cmd_Arg;
+
+/**
+ * 输出函数，格式同printf（如UART_printf），用于输出命令结果和错误信息。
+ */
+typedef int (*Cmd_PrintFunc)(const char *Fmt, ...);
+
+/**
+ * 命令处理函数。
+ * @param  Args 解析后的参数，类型与Cmd_Entry.Args一致。
+ * @param  Argc 实际参数个数（含可省略参数时可能少于Args中的字符数）。
+ * @param  Print 输出函数。
+ * @retval CMD_OK或错误码。
+ */
+typedef uint8_t (*Cmd_Handler)(const Cmd_Arg *Args, uint8_t Argc, Cmd_PrintFunc Print);
+
+// 命令表项
+typedef struct
+{
+    const char *Name;    // 命令名
+    const char *Args;    // 参数类型
+    Cmd_Handler Handler; // 处理函数
+    const char *Help;    // 帮助信息
+} Cmd_Entry;
+
+uint8_t Cmd_Exec(const Cmd_Entry *Table, uint8_t Num, char *Line, Cmd_PrintFunc Print); // 解析并执行一行命令。
+void Cmd_PrintHelp(const Cmd_Entry *Table, uint8_t Num, Cmd_PrintFunc Print);          // 输出命令列表。
+uint8_t Cmd_ParseInt(const char *Str, int32_t *Value);                                 // 将字符串转换为整数。
+uint8_t Cmd_ParseFloat(const char *Str, float *Value);                                 // 将字符串转换为浮点数。
+
+#endif
+
+/**
+  ***************************************************
+  * @example 命令解析例程
+  * @brief   串口接收一行命令并执行
+  ***************************************************
+    static uint8_t Led_Cmd(const Cmd_Arg *Args, uint8_t Argc, Cmd_PrintFunc Print)
+    {
+        // Args[0].i: 灯编号，Args[1].i: 状态（可省略，默认为1）
+        uint8_t on = (Argc > 1) ? Args[1].i : 1;
+        Print("led %d %d\n", Args[0].i, on);
+        return CMD_OK;
+    }
+
+    static const Cmd_Entry Cmds[] = {
+        {"led", "iI", Led_Cmd, "led <n> [0|1]"},
+    };
+
+    UART_init(115200);
+    while (1)
+    {
+        if (get_UART_RecStatus())
+        {
+            // USART_RX_BUF中的一行数据已去掉行结束符并以'\0'结尾
+            Cmd_Exec(Cmds, sizeof(Cmds) / sizeof(Cmds[0]), (char *)USART_RX_BUF, UART_printf);
+            Reset_UART_RecStatus();
+        }
+    }
+  ***************************************************
+  */
@@ -1,18 +1,126 @@
 #include "stm32f10x.h"
+#include "delay.h"
+
+static volatile uint64_t Delay_Ticks = 0; // 节拍计数
+
+/**
+ * @brief  启动SysTick时基，时钟源为HCLK，中断优先级最低。
+ *      重复调用不会重新配置；延时和计时函数在SysTick未启动时会自动调用本函数。
+ * @param  无
+ * @retval 无
+ */
+void Delay_Init(void)
+{
+    if (SysTick->CTRL & SysTick_CTRL_ENABLE)
+        return;
+    SysTick_Config(SystemCoreClock / DELAY_TICK_FREQ);
+}
+
+/**
+ * @brief  节拍计数加1，由SysTick_Handler调用。
+ * @param  无
+ * @retval 无
+ */
+void Delay_IncTick(void)
+{
+    Delay_Ticks++;
+}
+
+/**
+ * @brief  同时读取节拍计数和SysTick当前计数值。
+ *      SysTick已重装但中断尚未执行（关中断期间或更高优先级中断中）时，节拍计数补加1。
+ * @param  Val SysTick当前计数值（向下计数）。
+ * @retval 节拍计数
+ */
+static uint64_t Delay_Read(uint32_t *Val)
+{
+    uint32_t primask;
+    uint64_t ticks;
+
+    Delay_Init();
+    primask = __get_PRIMASK();
+    __disable_irq();
+    ticks = Delay_Ticks;
+    *Val = SysTick->VAL;
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET)
+    {
+        *Val = SysTick->VAL; // 重新读取，保证是重装之后的值
+        ticks++;
+    }
+    __set_PRIMASK(primask);
+    return ticks;
+}
+
+/**
+ * @brief  获取节拍计数。
+ * @param  无
+ * @retval 启动后的SysTick中断次数
+ */
+uint64_t Delay_GetTick(void)
+{
+    uint32_t val;
+    return Delay_Read(&val);
+}
+
+/**
+ * @brief  获取启动后经过的微秒数。
+ * @param  无
+ * @retval 微秒数
+ */
+uint64_t Delay_Micros(void)
+{
+    uint32_t val, load;
+    uint64_t ticks;
+
+    ticks = Delay_Read(&val);
+    load = SysTick->LOAD + 1;
+    return ticks * (1000000 / DELAY_TICK_FREQ) + (uint64_t)(load - val) * (1000000 / DELAY_TICK_FREQ) / load;
+}
 
 /**
- * @brief  微秒级延时
- * @param  xus 延时时长，范围：0~233015
+ * @brief  获取启动后经过的HCLK周期数，用于测量代码耗时。
+ * @param  无
+ * @retval 周期数的低32位，两次读数相减即为经过的周期数
+ */
+uint32_t Delay_Cycles(void)
+{
+    uint32_t val, load;
+    uint64_t ticks;
+
+    ticks = Delay_Read(&val);
+    load = SysTick->LOAD + 1;
+    return (uint32_t)ticks * load + (load - val);
+}
+
+/**
+ * @brief  获取启动后经过的毫秒数。
+ * @param  无
+ * @retval 毫秒数
+ */
+uint64_t Delay_Millis(void)
+{
+    return Delay_Micros() / 1000;
+}
+
+/**
+ * @brief  微秒级延时，按SysTick计数值累计经过的时钟周期，不修改SysTick配置。
+ * @param  xus 延时时长，范围：0 ~ 0xFFFFFFFF / (SystemCoreClock / 1000000)，72MHz时为0 ~ 59652323
  * @retval 无
  */
 void Delay_us(uint32_t xus)
 {
-    SysTick->LOAD = 72 * xus;   // 设置定时器重装值
-    SysTick->VAL = 0x00;        // 清空当前计数值
-    SysTick->CTRL = 0x00000005; // 设置时钟源为HCLK，启动定时器
-    while (!(SysTick->CTRL & 0x00010000))
-        ;                       // 等待计数到0
-    SysTick->CTRL = 0x00000004; // 关闭定时器
+    uint32_t load, last, now, elapsed = 0;
+    uint32_t cycles = xus * (SystemCoreClock / 1000000);
+
+    Delay_Init();
+    load = SysTick->LOAD + 1;
+    last = SysTick->VAL;
+    while (elapsed < cycles)
+    {
+        now = SysTick->VAL;
+        elapsed += (last >= now) ? (last - now) : (last + load - now); // 向下计数，经过重装时补加一个周期
+        last = now;
+    }
 }
 
 /**
@@ -1,8 +1,58 @@
 #ifndef __DELAY_H
 #define __DELAY_H
 
+#include "stdint.h"
+
+/**
+ * SysTick从Delay_Init()起持续运行，每1/DELAY_TICK_FREQ秒产生一次中断，累加64位节拍计数。
+ * Delay_Micros()、Delay_Millis()由节拍计数和SysTick当前计数值换算得到，换算系数取自SystemCoreClock。
+ * 延时函数只读取SysTick计数值，不修改SysTick配置，可在中断中或关中断时使用。
+ * 其他模块不应再修改SysTick的重装值和控制寄存器。
+ */
+#define DELAY_TICK_FREQ 1000 // SysTick中断频率（Hz）
+
+#if (1000000 % DELAY_TICK_FREQ) != 0
+#error "DELAY_TICK_FREQ must divide 1000000! See delay.h file."
+#endif
+
+void Delay_Init(void);         // 启动SysTick时基。
+void Delay_IncTick(void);      // 节拍计数加1，由SysTick_Handler调用。
+uint64_t Delay_GetTick(void);  // 获取节拍计数。
+uint64_t Delay_Micros(void);   // 获取启动后经过的微秒数。
+uint64_t Delay_Millis(void);   // 获取启动后经过的毫秒数。
+uint32_t Delay_Cycles(void);   // 获取启动后经过的HCLK周期数（低32位）。
+
 void Delay_us(uint32_t us);
 void Delay_ms(uint32_t ms);
 void Delay_s(uint32_t s);
 
 #endif
+
+/**
+  ***************************************************
+  * @example 超时等待例程
+  * @brief   等待串口接收完成，最多等待500ms
+  ***************************************************
+    uint32_t start = (uint32_t)Delay_Millis();
+
+    while (!get_UART_RecStatus())
+    {
+        if ((uint32_t)Delay_Millis() - start >= 500) // 32位相减，计数回绕时结果仍然正确
+            break;
+    }
+  ***************************************************
+  */
+
+/**
+  ***************************************************
+  * @example 代码耗时测量例程
+  * @brief   用Delay_Cycles()测量一段代码消耗的CPU周期数，不修改SysTick配置，
+  *          结果包含一次Delay_Cycles()调用的开销，可先测量空代码段得到该值再扣除
+  ***************************************************
+    uint32_t t0, cycles;
+
+    t0 = Delay_Cycles();
+    OLED_ShowNum(1, 1, 12345, 5, 8);
+    cycles = Delay_Cycles() - t0; // 32位相减，72MHz时约59秒回绕一次，只用于测量短时间
+  ***************************************************
+  */
@@ -0,0 +1,261 @@
+#include "stm32f10x.h"
+#include "fault.h"
+
+#define FAULT_MAGIC 0x46415554UL // "FAUT"
+
+#define Fault_Saved ((Fault_Record *)FAULT_RECORD_ADDR) // RAM末尾保留区
+
+// 故障记录不能超出保留区
+typedef char Fault_RecordSizeCheck[(sizeof(Fault_Record) <= FAULT_RECORD_SIZE) ? 1 : -1];
+
+uint64_t Fault_Stack[FAULT_STACK_SIZE / 8]; // 故障处理使用的独立栈（8字节对齐）
+
+void Fault_Capture(uint32_t *Frame, uint32_t ExcReturn);
+
+/**
+ * @brief  计算故障记录的校验和。
+ * @param  Rec 故障记录。
+ * @retval 校验和（Check之前所有字的和取反）
+ */
+static uint32_t Fault_Checksum(const Fault_Record *Rec)
+{
+    const uint32_t *p = (const uint32_t *)Rec;
+    uint32_t sum = 0;
+    uint8_t i;
+
+    for (i = 0; i < sizeof(Fault_Record) / 4 - 1; i++)
+        sum += p[i];
+    return ~sum;
+}
+
+/**
+ * @brief  判断栈中的一个字是否为返回地址：Thumb地址（最低位为1）位于Flash中，且前一条指令为BL或BLX。
+ * @param  Addr 栈中的字。
+ * @retval 1: 是，0: 否
+ */
+static uint8_t Fault_IsReturnAddr(uint32_t Addr)
+{
+    uint16_t hw1, hw2;
+
+    if (!(Addr & 1) || Addr < FLASH_BASE + 4 || Addr >= FAULT_FLASH_END)
+        return 0;
+    Addr &= ~1UL;
+    hw1 = *(const uint16_t *)(Addr - 4);
+    hw2 = *(const uint16_t *)(Addr - 2);
+    if ((hw1 & 0xF800) == 0xF000 && (hw2 & 0xD000) == 0xD000) // BL <label>
+        return 1;
+    if ((hw2 & 0xFF87) == 0x4780) // BLX Rm
+        return 1;
+    return 0;
+}
+
+/**
+ * @brief  记录故障现场并复位（由故障中断入口在独立栈上调用，不返回）。
+ * @param  Frame 硬件压栈帧地址（R0, R1, R2, R3, R12, LR, PC, xPSR）。
+ * @param  ExcReturn 进入故障中断时的LR。
+ * @retval 无
+ */
+void Fault_Capture(uint32_t *Frame, uint32_t ExcReturn)
+{
+    Fault_Record *rec = Fault_Saved;
+    uint32_t *sp, *end;
+    uint8_t i;
+
+    rec->Type = SCB->ICSR & SCB_ICSR_VECTACTIVE_Msk; // 当前异常号
+    rec->ExcReturn = ExcReturn;
+    rec->CFSR = SCB->CFSR;
+    rec->HFSR = SCB->HFSR;
+    rec->MMFAR = SCB->MMFAR;
+    rec->BFAR = SCB->BFAR;
+    rec->TraceNum = 0;
+    rec->SP = (uint32_t)Frame;
+
+    // 栈溢出时压栈帧可能不在RAM中，此时只记录状态寄存器
+    if ((uint32_t)Frame >= SRAM_BASE && (uint32_t)Frame + 32 <= FAULT_RECORD_ADDR && !((uint32_t)Frame & 3))
+    {
+        rec->R0 = Frame[0];
+        rec->R1 = Frame[1];
+        rec->R2 = Frame[2];
+        rec->R3 = Frame[3];
+        rec->R12 = Frame[4];
+        rec->LR = Frame[5];
+        rec->PC = Frame[6];
+        rec->xPSR = Frame[7];
+
+        // xPSR第9位表示压栈时为对齐到8字节额外压入了一个字
+        sp = Frame + 8 + ((Frame[7] >> 9) & 1);
+        rec->SP = (uint32_t)sp;
+
+        end = sp + FAULT_SCAN_WORDS;
+        if ((uint32_t)end > FAULT_RECORD_ADDR)
+            end = (uint32_t *)FAULT_RECORD_ADDR;
+        for (; sp < end && rec->TraceNum < FAULT_TRACE_DEPTH; sp++)
+        {
+            if (Fault_IsReturnAddr(*sp))
+                rec->Trace[rec->TraceNum++] = *sp;
+        }
+    }
+    else
+    {
+        rec->R0 = rec->R1 = rec->R2 = rec->R3 = rec->R12 = 0;
+        rec->LR = rec->PC = rec->xPSR = 0;
+    }
+    for (i = rec->TraceNum; i < FAULT_TRACE_DEPTH; i++)
+        rec->Trace[i] = 0;
+
+    rec->Magic = FAULT_MAGIC;
+    rec->Check = Fault_Checksum(rec);
+    __DSB();
+
+#if FAULT_RESET
+    NVIC_SystemReset();
+#endif
+    while (1)
+    {
+    }
+}
+
+/**
+ * 故障中断入口：根据EXC_RETURN的第2位取得压栈帧所在的栈（MSP或PSP），
+ * 再将MSP切换到独立的故障栈，跳转到Fault_Capture()。
+ * MemManage、BusFault、UsageFault直接跳转到HardFault_Handler，由ICSR中的VECTACTIVE区分异常类型。
+ */
+#if defined(__CC_ARM)
+__asm void HardFault_Handler(void)
+{
+    IMPORT  Fault_Capture
+    TST     LR, #4
+    ITE     EQ
+    MRSEQ   R0, MSP
+    MRSNE   R0, PSP
+    MOV     R1, LR
+    LDR     R2, =__cpp(&Fault_Stack[FAULT_STACK_SIZE / 8])
+    MSR     MSP, R2
+    B       Fault_Capture
+}
+
+__asm void MemManage_Handler(void)
+{
+    IMPORT  HardFault_Handler
+    B       HardFault_Handler
+}
+
+__asm void BusFault_Handler(void)
+{
+    IMPORT  HardFault_Handler
+    B       HardFault_Handler
+}
+
+__asm void UsageFault_Handler(void)
+{
+    IMPORT  HardFault_Handler
+    B       HardFault_Handler
+}
+#elif defined(__GNUC__) && defined(__arm__)
+#define FAULT_STR_(x) #x
+#define FAULT_STR(x) FAULT_STR_(x)
+
+__attribute__((naked)) void HardFault_Handler(void)
+{
+    __asm volatile(
+        "tst   lr, #4                 \n"
+        "ite   eq                     \n"
+        "mrseq r0, msp                \n"
+        "mrsne r0, psp                \n"
+        "mov   r1, lr                 \n"
+        "ldr   r2, =Fault_Stack + " FAULT_STR(FAULT_STACK_SIZE) "\n"
+        "msr   msp, r2                \n"
+        "b     Fault_Capture          \n");
+}
+
+__attribute__((naked)) void MemManage_Handler(void)
+{
+    __asm volatile("b HardFault_Handler\n");
+}
+
+__attribute__((naked)) void BusFault_Handler(void)
+{
+    __asm volatile("b HardFault_Handler\n");
+}
+
+__attribute__((naked)) void UsageFault_Handler(void)
+{
+    __asm volatile("b HardFault_Handler\n");
+}
+#endif
+
+/**
+ * @brief  使能MemManage、BusFault、UsageFault（否则均升级为HardFault）和除零UsageFault。
+ * @param  无
+ * @retval 无
+ */
+void Fault_Init(void)
+{
+    SCB->SHCSR |= SCB_SHCSR_MEMFAULTENA_Msk | SCB_SHCSR_BUSFAULTENA_Msk | SCB_SHCSR_USGFAULTENA_Msk;
+    SCB->CCR |= SCB_CCR_DIV_0_TRP_Msk;
+}
+
+/**
+ * @brief  获取上次的故障记录。
+ * @param  无
+ * @retval 故障记录，保留区内容无效（上电或已清除）时返回0
+ */
+const Fault_Record *Fault_GetRecord(void)
+{
+    const Fault_Record *rec = Fault_Saved;
+
+    if (rec->Magic != FAULT_MAGIC || rec->Check != Fault_Checksum(rec))
+        return 0;
+    return rec;
+}
+
+/**
+ * @brief  清除故障记录。
+ * @param  无
+ * @retval 无
+ */
+void Fault_Clear(void)
+{
+    Fault_Saved->Magic = 0;
+}
+
+/**
+ * @brief  输出上次的故障记录和复位原因，然后清除记录及RCC中的复位标志。
+ * @param  Print 输出函数。
+ * @retval 1: 有故障记录，0: 无
+ */
+uint8_t Fault_Report(Fault_PrintFunc Print)
+{
+    static const char *const Names[] = {"HardFault", "MemManage", "BusFault", "UsageFault"};
+    const Fault_Record *rec = Fault_GetRecord();
+    const char *reset;
+    uint8_t i;
+
+    if (rec == 0)
+        return 0;
+
+    if (RCC_GetFlagStatus(RCC_FLAG_IWDGRST) == SET)
+        reset = "independent watchdog";
+    else if (RCC_GetFlagStatus(RCC_FLAG_WWDGRST) == SET)
+        reset = "window watchdog";
+    else if (RCC_GetFlagStatus(RCC_FLAG_SFTRST) == SET)
+        reset = "software";
+    else if (RCC_GetFlagStatus(RCC_FLAG_PINRST) == SET)
+        reset = "NRST pin";
+    else
+        reset = "unknown";
+    RCC_ClearFlag();
+
+    Print("FAULT: %s, reset by %s\n",
+          (rec->Type >= FAULT_HARD && rec->Type <= FAULT_USAGE) ? Names[rec->Type - FAULT_HARD] : "unknown", reset);
+    Print("PC=%08X LR=%08X xPSR=%08X SP=%08X EXC_RETURN=%08X\n", rec->PC, rec->LR, rec->xPSR, rec->SP, rec->ExcReturn);
+    Print("R0=%08X R1=%08X R2=%08X R3=%08X R12=%08X\n", rec->R0, rec->R1, rec->R2, rec->R3, rec->R12);
+    Print("CFSR=%08X HFSR=%08X MMFAR=%08X BFAR=%08X\n", rec->CFSR, rec->HFSR, rec->MMFAR, rec->BFAR);
+    Print("trace:");
+    for (i = 0; i < rec->TraceNum && i < FAULT_TRACE_DEPTH; i++)
+        Print(" %08X", rec->Trace[i]);
+    Print("\n");
+
+    Fault_Clear();
+    return 1;
+}
@@ -0,0 +1,92 @@
+#ifndef __FAULT_H
+#define __FAULT_H
+
+#include "stdint.h"
+
+/**
+ * 故障现场记录（HardFault、MemManage、BusFault、UsageFault）。
+ * 进入故障中断后切换到独立的故障栈（原栈可能已溢出），记录压栈的寄存器、故障状态寄存器和调用栈，
+ * 写入RAM末尾FAULT_RECORD_SIZE字节的保留区，然后复位（或停住等待看门狗复位）。
+ * 保留区不属于编译器管理的RAM，启动代码不会清零，复位后内容保留（掉电后丢失），由魔数和校验和判断是否有效。
+ * 下次启动时调用Fault_Report(UART_printf)经串口输出记录及复位原因，输出后清除记录。
+ * 注意：
+ *   - 工程选项Target中IRAM1的Size须减去FAULT_RECORD_SIZE（本工程为0x5000 - 0x80 = 0x4F80），防止保留区被分配给变量或栈；
+ *   - 调用栈为扫描故障时栈中的返回地址（前一条指令为BL/BLX的Flash地址）得到，可能混入已失效的旧返回地址，
+ *     结合map文件或 arm-none-eabi-addr2line 查看对应函数；
+ *   - MMFAR/BFAR只在CFSR中MMARVALID(bit7)/BFARVALID(bit15)置位时有效。
+ * BKP数据寄存器（中容量器件共20字节）放不下完整记录，因此使用RAM保留区。
+ */
+#define FAULT_RAM_END 0x20005000UL     // RAM结束地址（STM32F103C8：20KB）
+#define FAULT_FLASH_END 0x08010000UL   // Flash结束地址（STM32F103C8：64KB），用于判断返回地址
+#define FAULT_RECORD_SIZE 0x80         // RAM末尾保留区大小（字节）
+#define FAULT_TRACE_DEPTH 8            // 调用栈最多记录的返回地址个数
+#define FAULT_SCAN_WORDS 128           // 调用栈最多扫描的栈深度（字）
+#define FAULT_STACK_SIZE 256           // 故障处理使用的独立栈大小（字节）
+#define FAULT_RESET 1                  // 记录后立即复位；为0时停在死循环中，等待看门狗复位或调试器连接
+
+#define FAULT_RECORD_ADDR (FAULT_RAM_END - FAULT_RECORD_SIZE) // 保留区起始地址
+
+#if (FAULT_RECORD_SIZE & 7) != 0 || (FAULT_STACK_SIZE & 7) != 0
+#error "FAULT_RECORD_SIZE and FAULT_STACK_SIZE must be multiples of 8! See fault.h file."
+#endif
+
+// 异常号（Fault_Record.Type）
+#define FAULT_HARD 3      // HardFault
+#define FAULT_MEMMANAGE 4 // MemManage
+#define FAULT_BUS 5       // BusFault
+#define FAULT_USAGE 6     // UsageFault
+
+// 故障记录
+typedef struct
+{
+    uint32_t Magic;                     // 有效标志
+    uint32_t Type;                      // 异常号，FAULT_HARD ~ FAULT_USAGE
+    uint32_t R0, R1, R2, R3, R12;       // 压栈的寄存器
+    uint32_t LR, PC, xPSR;              // 压栈的返回地址、故障指令地址、程序状态
+    uint32_t SP;                        // 故障前的栈指针，压栈失败时为压栈帧地址
+    uint32_t ExcReturn;                 // EXC_RETURN（进入故障中断时的LR）
+    uint32_t CFSR, HFSR, MMFAR, BFAR;   // 故障状态及地址寄存器
+    uint32_t TraceNum;                  // 调用栈返回地址个数
+    uint32_t Trace[FAULT_TRACE_DEPTH];  // 调用栈返回地址（由近及远）
+    uint32_t Check;                     // 校验和
+} Fault_Record;
+
+typedef int (*Fault_PrintFunc)(const char *Fmt, ...); // 输出函数，与UART_printf相同
+
+void Fault_Init(void);                          // 使能MemManage/BusFault/UsageFault和除零异常。
+const Fault_Record *Fault_GetRecord(void);      // 获取上次的故障记录，无记录时返回0。
+void Fault_Clear(void);                         // 清除故障记录。
+uint8_t Fault_Report(Fault_PrintFunc Print);    // 输出并清除故障记录，返回是否有记录。
+
+#endif
+
+/**
+  ***************************************************
+  * @example 故障记录例程
+  * @brief   启动时输出上次的故障记录，发送 "crash" 后读取不存在的地址触发BusFault，复位后输出记录
+  ***************************************************
+    volatile uint32_t x;
+
+    Delay_Init();
+    Fault_Init();
+    UART_init(115200);
+    Fault_Report(UART_printf);
+
+    while (1)
+    {
+        if (get_UART_RecStatus())
+        {
+            if (USART_RX_BUF[0] == 'c')
+                x = *(volatile uint32_t *)0x60000000; // FSMC区域，C8没有该外设
+            Reset_UART_RecStatus();
+        }
+    }
+
+    串口输出：
+    FAULT: BusFault, reset by software
+    PC=080012A6 LR=08001291 xPSR=61000000 SP=200005D8 EXC_RETURN=FFFFFFF9
+    R0=60000000 R1=00000000 R2=00000063 R3=20000024 R12=00000000
+    CFSR=00008200 HFSR=00000000 MMFAR=60000000 BFAR=60000000
+    trace: 08001291 080002D5
+  ***************************************************
+  */
@@ -0,0 +1,346 @@
+#include "format.h"
+
+#define FORMAT_LEFT 0x01  // '-' 左对齐
+#define FORMAT_ZERO 0x02  // '0' 补零
+#define FORMAT_PLUS 0x04  // '+' 正数显示加号
+#define FORMAT_SPACE 0x08 // ' ' 正数前留空格
+
+static const uint32_t Format_Pow10[FORMAT_FLOAT_PREC_MAX + 1] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+/**
+ * @brief  将无符号整数转换为数字字符（逆序存放）。
+ * @param  Buf 存放数字字符的数组，至少10个字节（十进制）或8个字节（十六进制）。
+ * @param  Number 要转换的数。
+ * @param  Radix 进制，10或16。
+ * @param  Upper 十六进制是否使用大写字母。
+ * @retval 数字字符个数。
+ */
+static uint8_t Format_UInt(char *Buf, uint32_t Number, uint8_t Radix, uint8_t Upper)
+{
+    const char *digits = Upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    uint8_t n = 0;
+
+    do
+    {
+        Buf[n++] = digits[Number % Radix];
+        Number /= Radix;
+    } while (Number);
+    return n;
+}
+
+/**
+ * @brief  格式化输出到回调函数。
+ * @param  Put 输出一个字符的回调函数。
+ * @param  Arg 传给Put的参数。
+ * @param  Fmt 格式字符串，支持的格式见format.h。
+ * @param  ap 可变参数列表。
+ * @retval 输出的字符数。
+ */
+int Format_vprintf(Format_PutFunc Put, void *Arg, const char *Fmt, va_list ap)
+{
+    char digits[12];                  // 逆序存放的数字字符
+    char frac[FORMAT_FLOAT_PREC_MAX]; // 逆序存放的小数部分
+    const char *s;
+    char sign;
+    uint8_t flags, ndig, nfrac;
+    int width, prec, len, pad;
+    int count = 0;
+    uint32_t u;
+    int32_t i;
+    union
+    {
+        double d;
+        uint64_t u;
+    } f;                              // %f 参数（可变参数中float被提升为double），只按位解析，不做浮点运算
+    uint64_t m;
+    uint16_t e, sh;
+
+    for (; *Fmt; Fmt++)
+    {
+        if (*Fmt != '%')
+        {
+            Put(*Fmt, Arg);
+            count++;
+            continue;
+        }
+
+        // 标志
+        flags = 0;
+        for (;;)
+        {
+            Fmt++;
+            if (*Fmt == '-')
+                flags |= FORMAT_LEFT;
+            else if (*Fmt == '0')
+                flags |= FORMAT_ZERO;
+            else if (*Fmt == '+')
+                flags |= FORMAT_PLUS;
+            else if (*Fmt == ' ')
+                flags |= FORMAT_SPACE;
+            else
+                break;
+        }
+
+        // 宽度
+        width = 0;
+        if (*Fmt == '*')
+        {
+            width = va_arg(ap, int);
+            if (width < 0)
+            {
+                flags |= FORMAT_LEFT;
+                width = -width;
+            }
+            Fmt++;
+        }
+        else
+        {
+            while (*Fmt >= '0' && *Fmt <= '9')
+                width = width * 10 + (*Fmt++ - '0');
+        }
+
+        // 精度
+        prec = -1;
+        if (*Fmt == '.')
+        {
+            prec = 0;
+            Fmt++;
+            while (*Fmt >= '0' && *Fmt <= '9')
+                prec = prec * 10 + (*Fmt++ - '0');
+        }
+
+        // 长度修饰符（int与long均为32位，直接忽略）
+        while (*Fmt == 'l' || *Fmt == 'h')
+            Fmt++;
+
+        sign = 0;
+        ndig = 0;
+        nfrac = 0;
+        s = digits;
+
+        switch (*Fmt)
+        {
+        case 'd':
+        case 'i':
+            i = va_arg(ap, int32_t);
+            if (i < 0)
+            {
+                sign = '-';
+                u = 0U - (uint32_t)i;
+            }
+            else
+            {
+                u = (uint32_t)i;
+            }
+            ndig = Format_UInt(digits, u, 10, 0);
+            break;
+
+        case 'u':
+            ndig = Format_UInt(digits, va_arg(ap, uint32_t), 10, 0);
+            break;
+
+        case 'x':
+        case 'X':
+            ndig = Format_UInt(digits, va_arg(ap, uint32_t), 16, *Fmt == 'X');
+            break;
+
+        case 'c':
+            digits[0] = (char)va_arg(ap, int);
+            ndig = 1;
+            flags &= ~FORMAT_ZERO;
+            break;
+
+        case 's':
+            s = va_arg(ap, const char *);
+            if (s == 0)
+                s = "(null)";
+            for (len = 0; s[len] && (prec < 0 || len < prec); len++)
+                ;
+            ndig = 0xFF; // 字符串正序输出，长度保存在len中
+            flags &= ~FORMAT_ZERO;
+            break;
+
+        case 'f':
+            f.d = va_arg(ap, double);
+            if (prec < 0)
+                prec = 6;
+            if (prec > FORMAT_FLOAT_PREC_MAX)
+                prec = FORMAT_FLOAT_PREC_MAX;
+
+            // IEEE 754双精度：1位符号、11位指数（偏移1023）、52位尾数
+            e = (uint16_t)(f.u >> 52) & 0x7FF;
+            m = f.u & 0x000FFFFFFFFFFFFFULL;
+            if (e == 0)
+                e = 1; // 非规格化数
+            else
+                m |= 1ULL << 52;
+            sh = 1075 - e; // 数值 = m / 2^sh
+            if (e >= 1023 + 32)
+                u = 0xFFFFFFFF;
+            else
+                u = (sh < 64) ? (uint32_t)(m >> sh) : 0;
+            if (e != 0x7FF || (m & 0x000FFFFFFFFFFFFFULL) == 0)
+            {
+                if (f.u >> 63)
+                    sign = '-';
+            }
+            if (u == 0xFFFFFFFF)
+            {
+                // 非数、无穷大或超出范围：输出文字，不补零
+                s = (e != 0x7FF) ? "ovf" : (m & 0x000FFFFFFFFFFFFFULL) ? "nan" : "inf";
+                len = 3;
+                ndig = 0xFF;
+                flags &= ~FORMAT_ZERO;
+                break;
+            }
+
+            // 定点转换：小数部分化为64位定点小数，乘10^prec后四舍五入（只用整数运算）
+            if (sh <= 64)
+                m <<= 64 - sh; // 移出整数部分
+            else
+                m = (sh < 128) ? m >> (sh - 64) : 0;
+            i = (int32_t)(((m >> 32) * Format_Pow10[prec] + (((m & 0xFFFFFFFF) * Format_Pow10[prec]) >> 32) + 0x80000000UL) >> 32);
+            if ((uint32_t)i >= Format_Pow10[prec])
+            {
+                i -= Format_Pow10[prec];
+                u++;
+            }
+            for (nfrac = 0; nfrac < prec; nfrac++)
+            {
+                frac[nfrac] = '0' + (uint32_t)i % 10;
+                i = (uint32_t)i / 10;
+            }
+            ndig = Format_UInt(digits, u, 10, 0);
+            break;
+
+        case '%':
+            Put('%', Arg);
+            count++;
+            continue;
+
+        default: // 不支持的格式，原样输出
+            if (*Fmt == '\0')
+                return count;
+            Put('%', Arg);
+            Put(*Fmt, Arg);
+            count += 2;
+            continue;
+        }
+
+        if (sign == 0 && (*Fmt == 'd' || *Fmt == 'i' || *Fmt == 'f'))
+        {
+            if (flags & FORMAT_PLUS)
+                sign = '+';
+            else if (flags & FORMAT_SPACE)
+                sign = ' ';
+        }
+
+        // 整数的精度表示最少数字位数
+        if (ndig != 0xFF && *Fmt != 'f' && *Fmt != 'c' && prec > ndig)
+        {
+            while (ndig < prec && ndig < sizeof(digits))
+                digits[ndig++] = '0';
+        }
+
+        // 计算输出总长度
+        if (ndig != 0xFF)
+            len = ndig + (nfrac ? nfrac + 1 : 0);
+        len += (sign != 0);
+        pad = (width > len) ? width - len : 0;
+        count += len + pad;
+
+        if (!(flags & (FORMAT_LEFT | FORMAT_ZERO)))
+            for (; pad > 0; pad--)
+                Put(' ', Arg);
+        if (sign)
+            Put(sign, Arg);
+        if (!(flags & FORMAT_LEFT))
+            for (; pad > 0; pad--)
+                Put('0', Arg);
+
+        if (ndig == 0xFF)
+        {
+            len -= (sign != 0);
+            while (len--)
+                Put(*s++, Arg);
+        }
+        else
+        {
+            while (ndig)
+                Put(digits[--ndig], Arg);
+            if (nfrac)
+            {
+                Put('.', Arg);
+                while (nfrac)
+                    Put(frac[--nfrac], Arg);
+            }
+        }
+
+        for (; pad > 0; pad--)
+            Put(' ', Arg);
+    }
+    return count;
+}
+
+// 输出到数组时的状态
+typedef struct
+{
+    char *Buf;
+    uint16_t Size;
+    uint16_t Len;
+} Format_BufState;
+
+/**
+ * @brief  输出一个字符到数组，超出数组大小的字符被丢弃。
+ * @param  c 要输出的字符。
+ * @param  Arg 指向Format_BufState。
+ * @retval 无
+ */
+static void Format_PutBuf(char c, void *Arg)
+{
+    Format_BufState *st = (Format_BufState *)Arg;
+
+    if (st->Len + 1 < st->Size) // 保留结尾'\0'的位置
+        st->Buf[st->Len++] = c;
+}
+
+/**
+ * @brief  格式化输出到数组，结果总以'\0'结尾。
+ * @param  Buf 存放结果的数组。
+ * @param  Size Buf的大小，超出部分被截断。
+ * @param  Fmt 格式字符串，支持的格式见format.h。
+ * @param  ap 可变参数列表。
+ * @retval 完整输出所需的字符数（不含'\0'），大于等于Size时表示结果被截断。
+ */
+int Format_vsnprintf(char *Buf, uint16_t Size, const char *Fmt, va_list ap)
+{
+    Format_BufState st;
+    int n;
+
+    st.Buf = Buf;
+    st.Size = Size;
+    st.Len = 0;
+    n = Format_vprintf(Format_PutBuf, &st, Fmt, ap);
+    if (Size)
+        Buf[st.Len] = '\0';
+    return n;
+}
+
+/**
+ * @brief  格式化输出到数组，结果总以'\0'结尾。
+ * @param  Buf 存放结果的数组。
+ * @param  Size Buf的大小，超出部分被截断。
+ * @param  Fmt 格式字符串，支持的格式见format.h。
+ * @retval 完整输出所需的字符数（不含'\0'），大于等于Size时表示结果被截断。
+ */
+int Format_snprintf(char *Buf, uint16_t Size, const char *Fmt, ...)
+{
+    va_list ap;
+    int n;
+
+    va_start(ap, Fmt);
+    n = Format_vsnprintf(Buf, Size, Fmt, ap);
+    va_end(ap);
+    return n;
+}
@@ -0,0 +1,71 @@
+#ifndef __FORMAT_H
+#define __FORMAT_H
+
+#include "stdint.h"
+#include "stdarg.h"
+
+/**
+ * 轻量格式化输出，不使用堆，不依赖C库的printf/sprintf。
+ * 支持的格式：%[标志][宽度][.精度][l]类型
+ *   - 标志: '-' 左对齐，'0' 补零，'+' 正数显示加号，' ' 正数前留空格
+ *   - 类型: d i u x X c s f %
+ *   - %f 以定点方式转换并四舍五入（恰好位于两数中间时与sprintf可能相差末位1），未指定精度时为6位小数，
+ *     精度最大为FORMAT_FLOAT_PREC_MAX位，整数部分超过uint32_t范围时输出"ovf"，非数输出"nan"，无穷大输出"inf"
+ *   - 可变参数中的float按C语言规则提升为double，%f 只按位解析该double（指数、尾数），转换全部用整数运算，
+ *     不调用软件双精度浮点库（Cortex-M3没有FPU）
+ */
+#define FORMAT_FLOAT_PREC_MAX 9 // %f 最大小数位数
+
+/**
+ * 输出一个字符的回调函数。
+ * @param  c 要输出的字符。
+ * @param  Arg 调用Format_vprintf()时传入的参数。
+ */
+typedef void (*Format_PutFunc)(char c, void *Arg);
+
+int Format_vprintf(Format_PutFunc Put, void *Arg, const char *Fmt, va_list ap); // 格式化输出到回调函数。
+int Format_vsnprintf(char *Buf, uint16_t Size, const char *Fmt, va_list ap);   // 格式化输出到数组。
+int Format_snprintf(char *Buf, uint16_t Size, const char *Fmt, ...);           // 格式化输出到数组。
+
+#endif
+
+/**
+  ***************************************************
+  * @example 格式化输出例程
+  * @brief   输出到数组或串口
+  ***************************************************
+    char str[32];
+    float Motor_now = 12.345f;
+
+    Format_snprintf(str, sizeof(str), "v=%.2f n=%5d", Motor_now, -42); // str: "v=12.35 n=  -42"
+    OLED_ShowString(1, 1, str, 8);
+
+    UART_printf("%.2f\n", Motor_now); // 直接输出到串口（经DMA发送队列）
+  ***************************************************
+  */
+
+/**
+  ***************************************************
+  * @example 与sprintf的耗时对比例程
+  * @brief   用Delay_Cycles()（delay.h）测量一次格式化消耗的CPU周期数。
+  *          Flash占用：编译后在Listings/project.map的Image component sizes中
+  *          比较format.o与C库中sprintf及浮点格式化相关目标文件（如__2sprintf.o、_printf_fp_dec.o）的Code + RO Data，
+  *          需注释掉sprintf一行重新编译，C库部分才会从Image中移除。
+  ***************************************************
+    #include "stdio.h"
+
+    char str[32];
+    volatile float v = -1234.5678f;
+    uint32_t t0, t1, cycles_format, cycles_sprintf;
+
+    t0 = Delay_Cycles();
+    Format_snprintf(str, sizeof(str), "%d,%.3f", 1000, v);
+    t1 = Delay_Cycles();
+    cycles_format = t1 - t0;
+
+    t0 = Delay_Cycles();
+    sprintf(str, "%d,%.3f", 1000, v);
+    t1 = Delay_Cycles();
+    cycles_sprintf = t1 - t0;
+  ***************************************************
+  */
@@ -0,0 +1,103 @@
+#include "stm32f10x.h"
+#include "profile.h"
+
+#define PROF_DWT_CTRL (*(volatile uint32_t *)0xE0001000) // DWT控制寄存器
+#define PROF_DWT_CTRL_CYCCNTENA 0x00000001               // CYCCNT使能位
+
+static Prof_Probe *Prof_List = 0;  // 统计表
+static uint32_t Prof_Overhead = 0; // PROF_BEGIN、PROF_END之间没有代码时测得的周期数
+
+/**
+ * @brief  启动DWT周期计数器，并测量读取计数器本身的开销。重复调用不会清零计数器。
+ * @param  无
+ * @retval 无
+ */
+void Prof_Init(void)
+{
+    uint32_t t0, t1;
+
+    if (!(PROF_DWT_CTRL & PROF_DWT_CTRL_CYCCNTENA))
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; // 使能DWT
+        PROF_CYCCNT = 0;
+        PROF_DWT_CTRL |= PROF_DWT_CTRL_CYCCNTENA;
+    }
+
+    t0 = PROF_CYCCNT;
+    t1 = PROF_CYCCNT;
+    Prof_Overhead = t1 - t0;
+}
+
+/**
+ * @brief  记录一次测量结果，第一次记录时把统计项加入统计表。
+ * @param  Probe 统计项。
+ * @param  Cycles 测得的周期数（含读取计数器的开销）。
+ * @retval 无
+ */
+void Prof_Record(Prof_Probe *Probe, uint32_t Cycles)
+{
+    uint32_t primask;
+
+    Cycles = (Cycles > Prof_Overhead) ? Cycles - Prof_Overhead : 0;
+
+    primask = __get_PRIMASK();
+    __disable_irq(); // 同一统计项可能在主循环和中断中同时使用
+    if (!Probe->Linked)
+    {
+        Probe->Linked = 1;
+        Probe->Next = Prof_List;
+        Prof_List = Probe;
+    }
+    if (Probe->Count == 0 || Cycles < Probe->Min)
+        Probe->Min = Cycles;
+    if (Cycles > Probe->Max)
+        Probe->Max = Cycles;
+    Probe->Count++;
+    Probe->Sum += Cycles;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  清零全部统计项（统计项仍保留在统计表中）。
+ * @param  无
+ * @retval 无
+ */
+void Prof_Reset(void)
+{
+    Prof_Probe *p;
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    for (p = Prof_List; p; p = p->Next)
+    {
+        p->Count = 0;
+        p->Min = 0;
+        p->Max = 0;
+        p->Sum = 0;
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  输出统计表，每个统计项一行：名称、次数、最小值、最大值、平均值（CPU周期数）。
+ * @param  Print 输出函数，如UART_printf。
+ * @retval 无
+ */
+void Prof_Dump(Prof_PrintFunc Print)
+{
+    Prof_Probe *p, s;
+    uint32_t primask;
+
+    Print("%-15s %8s %8s %8s %8s\n", "name", "count", "min", "max", "mean");
+    for (p = Prof_List; p; p = p->Next)
+    {
+        primask = __get_PRIMASK();
+        __disable_irq(); // 复制一份，输出期间不关中断
+        s = *p;
+        __set_PRIMASK(primask);
+
+        Print("%-15s %8u %8u %8u %8u\n", s.Name, s.Count, s.Min, s.Max,
+              s.Count ? (uint32_t)(s.Sum / s.Count) : 0);
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef __PROFILE_H
+#define __PROFILE_H
+
+#include "stdint.h"
+
+/**
+ * 基于DWT周期计数器（CYCCNT，每个CPU时钟加1）的耗时统计。
+ * 在要测量的代码前后加入PROF_BEGIN(名称)和PROF_END(名称)，每个名称对应一个统计项，
+ * 统计项在第一次执行PROF_END时自动加入统计表，记录次数、最小值、最大值和平均值（CPU周期数，已扣除测量本身的开销）。
+ * 调用Prof_Dump(UART_printf)输出统计表。
+ * 未定义PROFILE_ENABLE时PROF_BEGIN/PROF_END不产生任何代码，可以保留在源码中。
+ * PROF_CYCCNT和Prof_Init()不受PROFILE_ENABLE影响，可直接用于测量一段代码的周期数。
+ * 注意：CYCCNT为32位，72MHz时约59秒回绕一次，单次测量的代码耗时不能超过该时间。
+ */
+// #define PROFILE_ENABLE
+
+#define PROF_CYCCNT (*(volatile uint32_t *)0xE0001004) // DWT周期计数器
+
+// 统计项
+typedef struct Prof_Probe
+{
+    const char *Name;        // 名称
+    struct Prof_Probe *Next; // 统计表中的下一项
+    uint8_t Linked;          // 是否已加入统计表
+    uint32_t Count;          // 次数
+    uint32_t Min;            // 最小周期数
+    uint32_t Max;            // 最大周期数
+    uint64_t Sum;            // 周期数累加
+} Prof_Probe;
+
+typedef int (*Prof_PrintFunc)(const char *Fmt, ...); // 输出函数，与UART_printf相同
+
+#ifdef PROFILE_ENABLE
+/**
+ * 测量起点，定义统计项（静态变量）并记录起始计数值。与PROF_END成对使用，须在同一代码块中。
+ * name为C标识符，同时作为统计表中的名称。
+ */
+#define PROF_BEGIN(name)                                             \
+    static Prof_Probe Prof_Probe_##name = {#name, 0, 0, 0, 0, 0, 0}; \
+    uint32_t Prof_Start_##name = PROF_CYCCNT
+#define PROF_END(name) Prof_Record(&Prof_Probe_##name, PROF_CYCCNT - Prof_Start_##name) // 测量终点
+#else
+#define PROF_BEGIN(name) ((void)0)
+#define PROF_END(name) ((void)0)
+#endif
+
+void Prof_Init(void);                                 // 启动DWT周期计数器。
+void Prof_Record(Prof_Probe *Probe, uint32_t Cycles); // 记录一次测量结果（由PROF_END调用）。
+void Prof_Reset(void);                                // 清零全部统计项。
+void Prof_Dump(Prof_PrintFunc Print);                 // 输出统计表。
+
+#endif
+
+/**
+  ***************************************************
+  * @example 控制环耗时统计例程
+  * @brief   定义PROFILE_ENABLE后，PID_Compute、OLED_ShowFloat、USART1_IRQHandler中已有的统计项自动生效，
+  *          再加上主循环自身的统计项，每秒输出一次
+  ***************************************************
+    Prof_Init();
+    while (1)
+    {
+        PROF_BEGIN(MainLoop);
+        OLED_ShowFloat(1, 1, PID_Compute(&MotorPID, speed), 4, 2, 8);
+        PROF_END(MainLoop);
+
+        if ((uint32_t)Delay_Millis() - last >= 1000)
+        {
+            last = (uint32_t)Delay_Millis();
+            Prof_Dump(UART_printf);
+        }
+    }
+
+    // 输出格式（n为占位，各数值需在目标板上实测）：
+    // name               count      min      max     mean
+    // PID_Compute            n        n        n        n
+    // USART1_IRQ             n        n        n        n
+    // OLED_ShowFloat         n        n        n        n
+    // MainLoop               n        n        n        n
+  ***************************************************
+  */
@@ -0,0 +1,154 @@
+#ifndef __PT_H
+#define __PT_H
+
+#include "stdint.h"
+#include "delay.h"
+
+/**
+ * 无栈协程（protothread）。
+ * 协程是一个返回PT_WAITING/PT_ENDED的普通函数，等待时记录当前行号并返回，下次调用时从该行继续执行，
+ * 不需要独立的栈和动态内存，每个协程只占用一个PT结构体（8字节）。
+ * 协程函数由调度器任务（sched.h）或主循环反复调用，等待期间CPU可以运行其他任务或睡眠。
+ * 使用限制（与所有基于switch的协程相同）：
+ *   - 局部变量在等待后不保留，需要跨越等待的变量应定义为static或放在协程参数结构体中；
+ *   - PT_BEGIN与PT_END之间不能再使用switch语句（可用if代替）；
+ *   - 等待宏只能直接写在协程函数中，不能写在被调用的子函数中。
+ */
+
+#define PT_WAITING 0 // 协程正在等待
+#define PT_ENDED 1   // 协程已执行到PT_END
+
+typedef struct
+{
+    uint16_t LC;   // 继续执行的位置（行号），0为从头执行
+    uint32_t Tick; // PT_AWAIT_TICKS的起始节拍
+} PT;
+
+#define PT_INIT(pt) ((pt)->LC = 0) // 初始化协程，下次调用从头执行
+
+// 记录行号后有意落入下一个case，告知GCC 7及以上版本不报-Wimplicit-fallthrough
+#if defined(__GNUC__) && __GNUC__ >= 7
+#define PT_FALLTHROUGH __attribute__((fallthrough))
+#else
+#define PT_FALLTHROUGH ((void)0)
+#endif
+
+// 协程开始，必须是协程函数的第一条语句
+#define PT_BEGIN(pt) \
+    switch ((pt)->LC) \
+    {                 \
+    case 0:
+
+// 协程结束，必须是协程函数的最后一条语句；执行到此处后协程重新初始化并返回PT_ENDED
+#define PT_END(pt) \
+    }              \
+    (pt)->LC = 0;  \
+    return PT_ENDED
+
+// 等待条件成立，条件不成立时返回PT_WAITING，下次调用时重新判断
+#define PT_WAIT_UNTIL(pt, cond) \
+    do                          \
+    {                           \
+        (pt)->LC = __LINE__;    \
+        PT_FALLTHROUGH;         \
+    case __LINE__:              \
+        if (!(cond))            \
+            return PT_WAITING;  \
+    } while (0)
+
+// 让出一次CPU，下次调用时继续执行
+#define PT_YIELD(pt)         \
+    do                       \
+    {                        \
+        (pt)->LC = __LINE__; \
+        return PT_WAITING;   \
+    case __LINE__:;          \
+    } while (0)
+
+// 结束协程，返回PT_ENDED
+#define PT_EXIT(pt)      \
+    do                   \
+    {                    \
+        (pt)->LC = 0;    \
+        return PT_ENDED; \
+    } while (0)
+
+// 等待n个SysTick节拍（默认1ms）
+#define PT_AWAIT_TICKS(pt, n)                                                       \
+    do                                                                              \
+    {                                                                               \
+        (pt)->Tick = (uint32_t)Delay_GetTick();                                     \
+        PT_WAIT_UNTIL(pt, (uint32_t)Delay_GetTick() - (pt)->Tick >= (uint32_t)(n)); \
+    } while (0)
+
+// 等待标志不为0（如中断中置位的volatile变量），随后将其清零
+#define PT_AWAIT_FLAG(pt, flag)     \
+    do                              \
+    {                               \
+        PT_WAIT_UNTIL(pt, (flag)); \
+        (flag) = 0;                 \
+    } while (0)
+
+/**
+ * 等待指定事件：ev为协程函数收到的事件值（如调度器任务的Event参数），之后某次调用中等于expected时继续执行。
+ * 先让出一次CPU，本次调用的事件不算，因此可以在循环中反复等待同一个事件；
+ * 若要判断本次调用的事件，使用PT_WAIT_UNTIL(pt, ev == expected)。
+ */
+#define PT_AWAIT_EVENT(pt, ev, expected) \
+    do                                   \
+    {                                    \
+        (pt)->LC = __LINE__;             \
+        return PT_WAITING;               \
+    case __LINE__:                       \
+        if ((ev) != (expected))          \
+            return PT_WAITING;           \
+    } while (0)
+
+// 等待子协程执行结束
+#define PT_AWAIT_THREAD(pt, thread) PT_WAIT_UNTIL(pt, (thread) == PT_ENDED)
+
+#endif
+
+/**
+  ***************************************************
+  * @example 协程例程
+  * @brief   LED以200ms亮、800ms灭闪烁；按键中断置位标志后，串口输出一次。两者都不占用CPU等待
+  ***************************************************
+    static volatile uint8_t KeyPressed; // 按键中断中置1
+
+    static uint8_t BlinkThread(PT *pt)
+    {
+        PT_BEGIN(pt);
+        while (1)
+        {
+            GPIO_ResetBits(GPIOC, GPIO_Pin_13);
+            PT_AWAIT_TICKS(pt, 200);
+            GPIO_SetBits(GPIOC, GPIO_Pin_13);
+            PT_AWAIT_TICKS(pt, 800);
+        }
+        PT_END(pt);
+    }
+
+    static uint8_t KeyThread(PT *pt)
+    {
+        PT_BEGIN(pt);
+        while (1)
+        {
+            PT_AWAIT_FLAG(pt, KeyPressed);
+            UART_printf("key\n");
+        }
+        PT_END(pt);
+    }
+
+    static PT BlinkPt, KeyPt;
+
+    static void Threads(uint16_t Event) // 调度器周期任务，每1ms运行一次
+    {
+        BlinkThread(&BlinkPt);
+        KeyThread(&KeyPt);
+    }
+
+    Sched_AddTask("threads", Threads, 1);
+    Sched_Run();
+  ***************************************************
+  */
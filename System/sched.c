@@ -0,0 +1,275 @@
+#include "stm32f10x.h"
+#include "sched.h"
+#include "delay.h"
+#include "profile.h"
+
+#define SCHED_SLOT_VALID 0x80000000UL // 队列中的位置已写入事件
+
+typedef struct
+{
+    Sched_TaskFunc Func;
+    uint16_t Period;   // 运行周期（节拍数），0为只由事件触发
+    uint64_t Next;     // 下次运行的节拍计数
+    uint32_t Cycles;   // 当前统计窗口内的运行周期数
+} Sched_Task;
+
+static Sched_Task Sched_Tasks[SCHED_TASK_MAX];
+static Sched_TaskStat Sched_Stats[SCHED_TASK_MAX];
+static uint8_t Sched_TaskNum = 0;
+
+static volatile uint32_t Sched_Queue[SCHED_QUEUE_SIZE]; // 事件队列，SCHED_SLOT_VALID | 任务号 << 16 | 事件值
+static volatile uint32_t Sched_QHead = 0;                // 生产者预留的位置
+static volatile uint32_t Sched_QTail = 0;                // 消费者读取的位置
+static volatile uint32_t Sched_Dropped = 0;              // 队列满丢弃的事件数
+
+static uint64_t Sched_WindowStart = 0; // 当前统计窗口起始节拍
+static uint32_t Sched_WindowBusy = 0;  // 当前统计窗口内所有任务的运行周期数
+static uint16_t Sched_Load = 0;        // 上一个统计窗口的总CPU占用率（0.1%）
+
+/**
+ * @brief  添加任务，应在Sched_Run()之前调用。
+ * @param  Name 任务名，用于Sched_Dump()输出。
+ * @param  Func 任务函数。
+ * @param  Period 运行周期（SysTick节拍数，默认1ms），0为只由Sched_Post()投递的事件触发。
+ * @retval 任务号，已满时返回-1
+ */
+int8_t Sched_AddTask(const char *Name, Sched_TaskFunc Func, uint16_t Period)
+{
+    uint8_t n = Sched_TaskNum;
+
+    if (n >= SCHED_TASK_MAX)
+        return -1;
+
+    Prof_Init();
+    Sched_Tasks[n].Func = Func;
+    Sched_Tasks[n].Period = Period;
+    Sched_Tasks[n].Next = Delay_GetTick() + Period;
+    Sched_Tasks[n].Cycles = 0;
+    Sched_Stats[n].Name = Name;
+    Sched_Stats[n].Runs = 0;
+    Sched_Stats[n].MaxCycles = 0;
+    Sched_Stats[n].Load = 0;
+    Sched_TaskNum = n + 1;
+    return n;
+}
+
+/**
+ * @brief  修改任务运行周期，从当前节拍开始计时。只能在主程序或任务中调用。
+ * @param  Task 任务号。
+ * @param  Period 运行周期（节拍数），0为停止周期运行，只由事件触发（如协程结束后）。
+ * @retval 无
+ */
+void Sched_SetPeriod(uint8_t Task, uint16_t Period)
+{
+    if (Task >= Sched_TaskNum)
+        return;
+    Sched_Tasks[Task].Period = Period;
+    Sched_Tasks[Task].Next = Delay_GetTick() + Period;
+}
+
+/**
+ * @brief  投递事件，可在中断中调用。
+ *      先用LDREX/STREX预留队列位置，再写入事件；多个中断同时投递时互不干扰，不需要关中断。
+ * @param  Task 任务号。
+ * @param  Event 事件值（不应为SCHED_EVT_TICK）。
+ * @retval 1: 成功  0: 任务号无效或队列已满（计入Sched_GetDropCount()）
+ */
+uint8_t Sched_Post(uint8_t Task, uint16_t Event)
+{
+    uint32_t head;
+
+    if (Task >= Sched_TaskNum)
+        return 0;
+
+    do
+    {
+        head = __LDREXW((uint32_t *)&Sched_QHead);
+        if (head - Sched_QTail >= SCHED_QUEUE_SIZE)
+        {
+            __CLREX();
+            Sched_Dropped++;
+            return 0;
+        }
+    } while (__STREXW(head + 1, (uint32_t *)&Sched_QHead));
+
+    Sched_Queue[head & (SCHED_QUEUE_SIZE - 1)] = SCHED_SLOT_VALID | ((uint32_t)Task << 16) | Event;
+    return 1;
+}
+
+/**
+ * @brief  运行一个任务并统计运行周期数。
+ * @param  n 任务号。
+ * @param  Event 事件值。
+ * @retval 无
+ */
+static void Sched_Exec(uint8_t n, uint16_t Event)
+{
+    uint32_t t0, cycles;
+
+    t0 = PROF_CYCCNT;
+    Sched_Tasks[n].Func(Event);
+    cycles = PROF_CYCCNT - t0;
+
+    Sched_Tasks[n].Cycles += cycles;
+    Sched_WindowBusy += cycles;
+    Sched_Stats[n].Runs++;
+    if (cycles > Sched_Stats[n].MaxCycles)
+        Sched_Stats[n].MaxCycles = cycles;
+}
+
+/**
+ * @brief  统计窗口结束时计算CPU占用率。
+ * @param  Now 当前节拍计数。
+ * @retval 无
+ */
+static void Sched_UpdateLoad(uint64_t Now)
+{
+    uint32_t total;
+    uint8_t i;
+
+    if (Now - Sched_WindowStart < SCHED_LOAD_WINDOW)
+        return;
+
+    total = (uint32_t)((uint64_t)SystemCoreClock * (Now - Sched_WindowStart) / DELAY_TICK_FREQ / 1000); // 0.1%对应的周期数
+    if (total == 0)
+        total = 1;
+    for (i = 0; i < Sched_TaskNum; i++)
+    {
+        Sched_Stats[i].Load = Sched_Tasks[i].Cycles / total;
+        Sched_Tasks[i].Cycles = 0;
+    }
+    Sched_Load = Sched_WindowBusy / total;
+    Sched_WindowBusy = 0;
+    Sched_WindowStart = Now;
+}
+
+/**
+ * @brief  运行所有就绪任务：先处理队列中的全部事件，再运行到期的周期任务。
+ * @param  无
+ * @retval 本次运行的任务数
+ */
+uint8_t Sched_RunOnce(void)
+{
+    uint32_t slot;
+    uint64_t now;
+    uint8_t i, ran = 0;
+
+    // 事件，按投递顺序处理；位置已预留但尚未写入时停止，下次再处理
+    while (Sched_QTail != Sched_QHead)
+    {
+        slot = Sched_Queue[Sched_QTail & (SCHED_QUEUE_SIZE - 1)];
+        if (!(slot & SCHED_SLOT_VALID))
+            break;
+        Sched_Queue[Sched_QTail & (SCHED_QUEUE_SIZE - 1)] = 0;
+        Sched_QTail++;
+        Sched_Exec((slot >> 16) & 0xFF, slot & 0xFFFF);
+        ran++;
+    }
+
+    // 周期任务
+    now = Delay_GetTick();
+    for (i = 0; i < Sched_TaskNum; i++)
+    {
+        if (Sched_Tasks[i].Period && now >= Sched_Tasks[i].Next)
+        {
+            Sched_Tasks[i].Next += Sched_Tasks[i].Period;
+            if (Sched_Tasks[i].Next <= now) // 落后超过一个周期，不连续追赶
+                Sched_Tasks[i].Next = now + Sched_Tasks[i].Period;
+            Sched_Exec(i, SCHED_EVT_TICK);
+            ran++;
+        }
+    }
+
+    Sched_UpdateLoad(now);
+    return ran;
+}
+
+/**
+ * @brief  判断是否有就绪的任务。
+ * @param  无
+ * @retval 1: 有  0: 无
+ */
+static uint8_t Sched_Ready(void)
+{
+    uint64_t now = Delay_GetTick();
+    uint8_t i;
+
+    if (Sched_QTail != Sched_QHead)
+        return 1;
+    for (i = 0; i < Sched_TaskNum; i++)
+    {
+        if (Sched_Tasks[i].Period && now >= Sched_Tasks[i].Next)
+            return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief  调度主循环，不返回。没有就绪任务时关中断检查后执行WFI，
+ *      检查与睡眠之间到来的中断会使WFI立即返回，不会丢失唤醒。
+ * @param  无
+ * @retval 无
+ */
+void Sched_Run(void)
+{
+    Delay_Init();
+    Prof_Init();
+    Sched_WindowStart = Delay_GetTick();
+
+    while (1)
+    {
+        if (Sched_RunOnce())
+            continue;
+
+        __disable_irq();
+        if (!Sched_Ready())
+            __WFI();
+        __enable_irq();
+    }
+}
+
+/**
+ * @brief  获取任务统计。
+ * @param  Task 任务号。
+ * @retval 任务统计，任务号无效时返回0
+ */
+const Sched_TaskStat *Sched_GetStat(uint8_t Task)
+{
+    return (Task < Sched_TaskNum) ? &Sched_Stats[Task] : 0;
+}
+
+/**
+ * @brief  获取上一个统计窗口内所有任务的总CPU占用率，其余时间为睡眠或中断。
+ * @param  无
+ * @retval CPU占用率（0.1%）
+ */
+uint16_t Sched_GetLoad(void)
+{
+    return Sched_Load;
+}
+
+/**
+ * @brief  获取队列满丢弃的事件数。
+ * @param  无
+ * @retval 丢弃的事件数
+ */
+uint32_t Sched_GetDropCount(void)
+{
+    return Sched_Dropped;
+}
+
+/**
+ * @brief  输出各任务的运行次数、单次最长周期数和CPU占用率。
+ * @param  Print 输出函数，如UART_printf。
+ * @retval 无
+ */
+void Sched_Dump(Sched_PrintFunc Print)
+{
+    uint8_t i;
+
+    Print("%-10s %6s %9s %6s\n", "task", "runs", "max cyc", "load%");
+    for (i = 0; i < Sched_TaskNum; i++)
+        Print("%-10s %6u %9u %4u.%u\n", Sched_Stats[i].Name, Sched_Stats[i].Runs,
+              Sched_Stats[i].MaxCycles, Sched_Stats[i].Load / 10, Sched_Stats[i].Load % 10);
+    Print("%-10s %6s %9s %4u.%u\n", "total", "", "", Sched_Load / 10, Sched_Load % 10);
+}
@@ -0,0 +1,103 @@
+#ifndef __SCHED_H
+#define __SCHED_H
+
+#include "stdint.h"
+
+/**
+ * 协作式调度器（run-to-completion，任务函数运行完毕才会切换到下一个任务，任务之间不会互相抢占）。
+ *   - 周期任务：按SysTick节拍计数（delay.h）每Period个节拍运行一次，节拍计数落后时只补运行一次，不会连续追赶；
+ *   - 事件任务：中断或其他任务调用Sched_Post()投递事件，调度器按投递顺序运行对应任务，事件值作为参数传入。
+ * 事件队列为多生产者单消费者无锁队列（LDREX/STREX预留位置），Sched_Post()可在任意中断中调用。
+ * 没有可运行的任务时执行WFI进入睡眠，由SysTick或其他中断唤醒。
+ * 每个任务的CPU占用率由DWT周期计数器（profile.h）统计，每SCHED_LOAD_WINDOW个节拍更新一次。
+ * 任务函数中不应调用Delay_ms等长时间阻塞的函数，否则会推迟其他任务。
+ */
+#define SCHED_TASK_MAX 8      // 最多任务数
+#define SCHED_QUEUE_SIZE 16   // 事件队列长度，必须是2的整数次幂
+#define SCHED_LOAD_WINDOW 1000 // CPU占用率统计窗口（节拍数）
+
+#if (SCHED_QUEUE_SIZE & (SCHED_QUEUE_SIZE - 1)) != 0
+#error "SCHED_QUEUE_SIZE must be a power of two! See sched.h file."
+#endif
+
+#define SCHED_EVT_TICK 0 // 周期运行时传入的事件值，Sched_Post()投递的事件值应不为0
+
+/**
+ * 任务函数。
+ * Event: 周期运行时为SCHED_EVT_TICK，事件运行时为Sched_Post()投递的事件值。
+ */
+typedef void (*Sched_TaskFunc)(uint16_t Event);
+
+// 任务统计
+typedef struct
+{
+    const char *Name;   // 任务名
+    uint32_t Runs;      // 运行次数
+    uint32_t MaxCycles; // 单次运行最长周期数
+    uint16_t Load;      // 上一个统计窗口内的CPU占用率（0.1%）
+} Sched_TaskStat;
+
+typedef int (*Sched_PrintFunc)(const char *Fmt, ...); // 输出函数，与UART_printf相同
+
+int8_t Sched_AddTask(const char *Name, Sched_TaskFunc Func, uint16_t Period); // 添加任务，返回任务号，已满返回-1。
+void Sched_SetPeriod(uint8_t Task, uint16_t Period);                          // 修改任务运行周期，0为停止周期运行。
+uint8_t Sched_Post(uint8_t Task, uint16_t Event);                            // 投递事件，队列满返回0。
+uint8_t Sched_RunOnce(void);                                                 // 运行所有就绪任务，返回运行的任务数。
+void Sched_Run(void);                                                        // 调度主循环，不返回。
+const Sched_TaskStat *Sched_GetStat(uint8_t Task);                           // 获取任务统计。
+uint16_t Sched_GetLoad(void);                                                // 获取总CPU占用率（0.1%）。
+uint32_t Sched_GetDropCount(void);                                           // 获取队列满丢弃的事件数。
+void Sched_Dump(Sched_PrintFunc Print);                                      // 输出各任务统计。
+
+#endif
+
+/**
+  ***************************************************
+  * @example 调度器例程
+  * @brief   每500ms闪烁LED；串口每收到一帧数据，在中断中投递事件，由echo任务回显；每5s输出一次CPU占用率
+  ***************************************************
+    static int8_t EchoTask;
+
+    static void Blink(uint16_t Event)
+    {
+        GPIOC->ODR ^= GPIO_Pin_13;
+    }
+
+    static void Echo(uint16_t Event)
+    {
+        uint8_t buf[64];
+        int16_t len;
+
+        while ((len = UART_ReadFrame(buf, sizeof(buf))) > 0)
+            UART_Write(buf, len);
+    }
+
+    static void Report(uint16_t Event)
+    {
+        Sched_Dump(UART_printf);
+    }
+
+    static void OnFrame(void) // 串口中断中调用
+    {
+        Sched_Post(EchoTask, 1);
+    }
+
+    int main(void)
+    {
+        Delay_Init();
+        UART_init(115200);
+        Sched_AddTask("blink", Blink, 500);
+        EchoTask = Sched_AddTask("echo", Echo, 0);
+        Sched_AddTask("report", Report, 5000);
+        UART_SetRxCallback(OnFrame);
+        Sched_Run();
+    }
+
+    // 输出格式（n为占位，各数值需在目标板上实测）：
+    // task         runs   max cyc  load%
+    // blink           n         n    n.n
+    // echo            n         n    n.n
+    // report          n         n    n.n
+    // total                          n.n
+  ***************************************************
+  */
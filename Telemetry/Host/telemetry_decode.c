@@ -0,0 +1,158 @@
+/**
+ * 上位机遥测解码工具：从标准输入（或文件）读取串口原始数据，按0x00划分帧并解码，以CSV格式输出到标准输出。
+ *
+ * 编译（在工程根目录）：
+ *   gcc -ITelemetry Telemetry/Host/telemetry_decode.c Telemetry/Telemetry_Proto.c -o telemetry_decode
+ * 使用：
+ *   telemetry_decode capture.bin > log.csv
+ *   telemetry_decode < /dev/ttyUSB0 > log.csv   (串口需先设置为921600 raw模式)
+ *   telemetry_decode --selftest                 (编码/解码回环自检)
+ *
+ * 丢帧、CRC错误等统计信息输出到标准错误。
+ */
+#include <stdio.h>
+#include <string.h>
+#include "Telemetry_Proto.h"
+
+static unsigned long Frames, CrcErrors, FormatErrors, Lost, Unknown;
+
+/**
+ * @brief  解码一帧并输出。
+ * @param  Buf 编码数据（不含0x00）。
+ * @param  Len 编码数据长度。
+ * @retval 无
+ */
+static void Decode_Frame(const uint8_t *Buf, uint16_t Len)
+{
+    static int last_seq = -1;
+    uint8_t work[TELEMETRY_COBS_MAX];
+    Telemetry_Record rec;
+    Telemetry_PID pid;
+    int8_t ret;
+
+    if (Len == 0)
+        return;
+    if (Len > TELEMETRY_COBS_MAX)
+    {
+        FormatErrors++;
+        return;
+    }
+
+    ret = Telemetry_DecodeFrame(Buf, Len, work, &rec);
+    if (ret == -2)
+    {
+        CrcErrors++;
+        return;
+    }
+    if (ret != 0)
+    {
+        FormatErrors++;
+        return;
+    }
+
+    Frames++;
+    if (last_seq >= 0)
+        Lost += (uint8_t)(rec.Seq - last_seq - 1);
+    last_seq = rec.Seq;
+
+    if (rec.Version == TELEMETRY_VERSION && rec.Type == TELEMETRY_TYPE_PID && rec.Len >= TELEMETRY_PID_LEN)
+    {
+        Telemetry_UnpackPID(rec.Payload, &pid);
+        printf("%lu,%u,%g,%g,%g,%g,%g,%g\n", (unsigned long)pid.Timestamp, rec.Seq,
+               pid.Setpoint, pid.Measurement, pid.P, pid.I, pid.D, pid.Output);
+    }
+    else
+    {
+        Unknown++;
+    }
+}
+
+/**
+ * @brief  编码/解码回环自检（与单片机上的Telemetry_SelfTest()使用同一套编解码函数）。
+ * @param  无
+ * @retval 0: 通过，1: 失败
+ */
+static int Decode_SelfTest(void)
+{
+    uint8_t frame[TELEMETRY_FRAME_MAX], cobs[TELEMETRY_COBS_MAX], work[TELEMETRY_COBS_MAX];
+    Telemetry_PID in = {0x00FF0100, 100.0f, -12.5f, 0.0f, 3.25f, -0.125f, 1000.0f}, out;
+    Telemetry_Record rec;
+    uint32_t crc;
+    uint16_t n;
+
+    frame[0] = TELEMETRY_VERSION;
+    frame[1] = TELEMETRY_TYPE_PID;
+    frame[2] = Telemetry_PackPID(&in, frame + TELEMETRY_HEADER_LEN);
+    frame[3] = 0xA5;
+    crc = Telemetry_CRC32(frame, TELEMETRY_HEADER_LEN + frame[2]);
+    n = TELEMETRY_HEADER_LEN + frame[2];
+    frame[n] = (uint8_t)crc;
+    frame[n + 1] = (uint8_t)(crc >> 8);
+    frame[n + 2] = (uint8_t)(crc >> 16);
+    frame[n + 3] = (uint8_t)(crc >> 24);
+
+    n = Telemetry_COBSEncode(frame, n + 4, cobs);
+    if (memchr(cobs, 0, n - 1) != NULL || Telemetry_DecodeFrame(cobs, n - 1, work, &rec) != 0)
+        return 1;
+    Telemetry_UnpackPID(rec.Payload, &out);
+    if (memcmp(&in, &out, sizeof(in)) != 0 || rec.Seq != 0xA5)
+        return 1;
+
+    cobs[4] ^= 0x01; // 破坏序号字节，应检出CRC错误
+    if (Telemetry_DecodeFrame(cobs, n - 1, work, &rec) != -2)
+        return 1;
+
+    // 与STM32硬件CRC的已知结果比较：CRC_CalcCRC(0x12345678) == 0xDF8A8A2B
+    if (Telemetry_CRC32((const uint8_t *)"\x78\x56\x34\x12", 4) != 0xDF8A8A2B)
+        return 1;
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    static uint8_t buf[TELEMETRY_COBS_MAX + 1];
+    uint16_t len = 0;
+    uint8_t overflow = 0;
+    FILE *in = stdin;
+    int c;
+
+    if (argc > 1 && strcmp(argv[1], "--selftest") == 0)
+    {
+        int ret = Decode_SelfTest();
+        fprintf(stderr, "selftest %s\n", ret ? "FAILED" : "passed");
+        return ret;
+    }
+    if (argc > 1 && (in = fopen(argv[1], "rb")) == NULL)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    printf("timestamp,seq,setpoint,measurement,p,i,d,output\n");
+    while ((c = fgetc(in)) != EOF)
+    {
+        if (c == 0)
+        {
+            if (overflow)
+                FormatErrors++;
+            else
+                Decode_Frame(buf, len);
+            len = 0;
+            overflow = 0;
+        }
+        else if (len < sizeof(buf))
+        {
+            buf[len++] = (uint8_t)c;
+        }
+        else
+        {
+            overflow = 1; // 帧过长，丢弃到下一个0x00
+        }
+    }
+
+    fprintf(stderr, "frames %lu, lost %lu, crc errors %lu, format errors %lu, unknown %lu\n",
+            Frames, Lost, CrcErrors, FormatErrors, Unknown);
+    if (in != stdin)
+        fclose(in);
+    return 0;
+}
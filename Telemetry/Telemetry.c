@@ -0,0 +1,229 @@
+#include "Telemetry.h"
+#include "USART.h"
+
+static uint8_t Telemetry_Seq;      // 帧序号
+static uint32_t Telemetry_Dropped; // Telemetry_Send()/Telemetry_Poll()因串口发送队列已满丢弃的帧数（主程序）
+static uint32_t Telemetry_PostDropped; // Telemetry_Post()因遥测队列已满丢弃的帧数（中断）
+
+/**
+ * 遥测队列（单生产者：Telemetry_Post()所在的中断，单消费者：主程序），无需关中断。
+ * 每帧存放为 [编码长度][COBS编码数据]，Telemetry_QHead只由生产者写入，Telemetry_QTail只由消费者写入，
+ * 两者为自由递增的计数值，用 (计数值 & (TELEMETRY_QUEUE_SIZE - 1)) 得到数组下标。
+ */
+static uint8_t Telemetry_Queue[TELEMETRY_QUEUE_SIZE];
+static volatile uint16_t Telemetry_QHead;
+static volatile uint16_t Telemetry_QTail;
+
+/**
+ * @brief  初始化遥测发送（使能CRC时钟），串口需另行调用UART_init()初始化。
+ * @param  无
+ * @retval 无
+ */
+void Telemetry_Init(void)
+{
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC, ENABLE);
+    Telemetry_Seq = 0;
+    Telemetry_Dropped = 0;
+    Telemetry_PostDropped = 0;
+    Telemetry_QHead = 0;
+    Telemetry_QTail = 0;
+}
+
+/**
+ * @brief  组装一帧（帧头 + 负载 + 硬件CRC32）并COBS编码。
+ *      分配帧序号和使用硬件CRC单元时关中断，可在主程序和中断中同时调用。
+ * @param  Type 记录类型。
+ * @param  Payload 负载数据。
+ * @param  Len 负载长度，必须是4的倍数且不超过TELEMETRY_PAYLOAD_MAX。
+ * @param  Seq 指定的帧序号（自检用），为0（空指针）时使用并递增Telemetry_Seq。
+ * @param  Dst 编码结果，至少TELEMETRY_COBS_MAX个字节。
+ * @retval 编码结果长度（含结尾0x00）；参数错误时返回0。
+ */
+static uint16_t Telemetry_Build(uint8_t Type, const uint8_t *Payload, uint8_t Len, const uint8_t *Seq, uint8_t *Dst)
+{
+    uint32_t frame[TELEMETRY_FRAME_MAX / 4]; // 按字对齐，供硬件CRC按字读取
+    uint8_t *p = (uint8_t *)frame;
+    uint16_t body = TELEMETRY_HEADER_LEN + Len;
+    uint32_t crc, primask;
+    uint8_t i;
+
+    if ((Len & 3) != 0 || Len > TELEMETRY_PAYLOAD_MAX)
+        return 0;
+
+    p[0] = TELEMETRY_VERSION;
+    p[1] = Type;
+    p[2] = Len;
+    for (i = 0; i < Len; i++)
+        p[TELEMETRY_HEADER_LEN + i] = Payload[i];
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    p[3] = Seq ? *Seq : Telemetry_Seq++;
+    CRC_ResetDR();
+    crc = CRC_CalcBlockCRC(frame, body / 4);
+    __set_PRIMASK(primask);
+    p[body] = (uint8_t)crc;
+    p[body + 1] = (uint8_t)(crc >> 8);
+    p[body + 2] = (uint8_t)(crc >> 16);
+    p[body + 3] = (uint8_t)(crc >> 24);
+
+    return Telemetry_COBSEncode(p, body + 4, Dst);
+}
+
+/**
+ * @brief  发送一条记录，编码后放入串口发送队列，由DMA在后台发送。只能在主程序中调用。
+ * @param  Type 记录类型。
+ * @param  Payload 负载数据。
+ * @param  Len 负载长度，必须是4的倍数且不超过TELEMETRY_PAYLOAD_MAX。
+ * @retval 状态值
+ *      - \b 0 : 已放入发送队列
+ *      - \b 1 : 参数错误或发送队列放不下整帧，帧被丢弃
+ */
+uint8_t Telemetry_Send(uint8_t Type, const uint8_t *Payload, uint8_t Len)
+{
+    uint8_t cobs[TELEMETRY_COBS_MAX];
+    uint16_t n = Telemetry_Build(Type, Payload, Len, 0, cobs);
+
+    if (n == 0)
+        return 1;
+    if (UART_TxFree() < n) // 先确认能放下整帧，不发送不完整的帧
+    {
+        Telemetry_Dropped++;
+        return 1;
+    }
+    UART_Write(cobs, n);
+    return 0;
+}
+
+/**
+ * @brief  将一条记录编码后放入遥测队列，由Telemetry_Poll()转入串口发送队列。
+ *      可在中断中调用，但只能在同一个中断中调用（单生产者）。
+ * @param  Type 记录类型。
+ * @param  Payload 负载数据。
+ * @param  Len 负载长度，必须是4的倍数且不超过TELEMETRY_PAYLOAD_MAX。
+ * @retval 状态值
+ *      - \b 0 : 已放入遥测队列
+ *      - \b 1 : 参数错误或遥测队列放不下整帧，帧被丢弃
+ */
+uint8_t Telemetry_Post(uint8_t Type, const uint8_t *Payload, uint8_t Len)
+{
+    uint8_t cobs[TELEMETRY_COBS_MAX];
+    uint16_t n = Telemetry_Build(Type, Payload, Len, 0, cobs);
+    uint16_t head = Telemetry_QHead;
+    uint16_t i;
+
+    if (n == 0)
+        return 1;
+    if (TELEMETRY_QUEUE_SIZE - (uint16_t)(head - Telemetry_QTail) < n + 1)
+    {
+        Telemetry_PostDropped++;
+        return 1;
+    }
+
+    Telemetry_Queue[head++ & (TELEMETRY_QUEUE_SIZE - 1)] = (uint8_t)n;
+    for (i = 0; i < n; i++)
+        Telemetry_Queue[head++ & (TELEMETRY_QUEUE_SIZE - 1)] = cobs[i];
+    Telemetry_QHead = head; // 整帧写入后才更新，消费者不会读到半帧
+    return 0;
+}
+
+/**
+ * @brief  将一条PID采样记录放入遥测队列（中断中调用）。
+ * @param  Rec PID采样记录。
+ * @retval 状态值，同Telemetry_Post()
+ */
+uint8_t Telemetry_PostPID(const Telemetry_PID *Rec)
+{
+    uint8_t payload[TELEMETRY_PID_LEN];
+    return Telemetry_Post(TELEMETRY_TYPE_PID, payload, Telemetry_PackPID(Rec, payload));
+}
+
+/**
+ * @brief  将遥测队列中的帧依次转入串口发送队列。只能在主程序中调用（如调度器周期任务）。
+ *      串口发送队列放不下下一整帧时停止，剩余的帧留到下次调用；遥测队列已满时由Telemetry_Post()丢弃新帧。
+ * @param  无
+ * @retval 无
+ */
+void Telemetry_Poll(void)
+{
+    uint8_t cobs[TELEMETRY_COBS_MAX];
+    uint16_t tail = Telemetry_QTail;
+    uint16_t i, n;
+
+    while (tail != Telemetry_QHead)
+    {
+        n = Telemetry_Queue[tail & (TELEMETRY_QUEUE_SIZE - 1)];
+        if (UART_TxFree() < n)
+            break;
+        for (i = 0; i < n; i++)
+            cobs[i] = Telemetry_Queue[(tail + 1 + i) & (TELEMETRY_QUEUE_SIZE - 1)];
+        tail += n + 1;
+        Telemetry_QTail = tail;
+        UART_Write(cobs, n);
+    }
+}
+
+/**
+ * @brief  发送一条PID采样记录。
+ * @param  Rec PID采样记录。
+ * @retval 状态值，同Telemetry_Send()
+ */
+uint8_t Telemetry_SendPID(const Telemetry_PID *Rec)
+{
+    uint8_t payload[TELEMETRY_PID_LEN];
+    return Telemetry_Send(TELEMETRY_TYPE_PID, payload, Telemetry_PackPID(Rec, payload));
+}
+
+/**
+ * @brief  获取因串口发送队列或遥测队列已满而丢弃的帧数。
+ * @param  无
+ * @retval 帧数
+ */
+uint32_t Telemetry_GetDropCount(void)
+{
+    return Telemetry_Dropped + Telemetry_PostDropped;
+}
+
+/**
+ * @brief  编码/解码回环自检：用硬件CRC组帧，再用上位机同样的解码函数（软件CRC）解码，比较结果。
+ *      不经过串口，可在上电时调用以确认硬件CRC与上位机解码器一致。
+ * @param  无
+ * @retval 状态值
+ *      - \b 0 : 通过
+ *      - \b 1 : 解码失败（CRC或格式错误）
+ *      - \b 2 : 解码结果与原始记录不一致
+ */
+uint8_t Telemetry_SelfTest(void)
+{
+    Telemetry_PID in, out;
+    Telemetry_Record rec;
+    uint8_t payload[TELEMETRY_PID_LEN];
+    uint8_t cobs[TELEMETRY_COBS_MAX];
+    uint8_t work[TELEMETRY_COBS_MAX];
+    uint8_t seq = 0xA5;
+    uint16_t n;
+
+    in.Timestamp = 0x00FF0100; // 含0x00字节，检验COBS编码
+    in.Setpoint = 100.0f;
+    in.Measurement = -12.5f;
+    in.P = 0.0f;
+    in.I = 3.25f;
+    in.D = -0.125f;
+    in.Output = 1000.0f;
+
+    n = Telemetry_Build(TELEMETRY_TYPE_PID, payload, Telemetry_PackPID(&in, payload), &seq, cobs);
+    if (n == 0 || cobs[n - 1] != 0x00)
+        return 1;
+    if (Telemetry_DecodeFrame(cobs, n - 1, work, &rec) != 0)
+        return 1;
+    if (rec.Version != TELEMETRY_VERSION || rec.Type != TELEMETRY_TYPE_PID ||
+        rec.Seq != 0xA5 || rec.Len != TELEMETRY_PID_LEN)
+        return 2;
+
+    Telemetry_UnpackPID(rec.Payload, &out);
+    if (out.Timestamp != in.Timestamp || out.Setpoint != in.Setpoint ||
+        out.Measurement != in.Measurement || out.P != in.P || out.I != in.I ||
+        out.D != in.D || out.Output != in.Output)
+        return 2;
+    return 0;
+}
@@ -0,0 +1,77 @@
+#ifndef __TELEMETRY_H
+#define __TELEMETRY_H
+
+#include "stm32f10x.h"
+#include "Telemetry_Proto.h"
+
+/**
+ * 二进制遥测发送，帧格式见Telemetry_Proto.h。
+ * CRC由STM32硬件CRC单元计算（关中断保护，可在主程序和中断中同时使用），编码后的帧放入串口发送队列由DMA发送（见USART.h），
+ * 函数不等待发送完成。串口发送队列只能由主程序写入，因此：
+ *   - 主程序中调用Telemetry_Send()直接放入串口发送队列；
+ *   - 中断（如CtrlTick控制函数）中调用Telemetry_Post()，编码后的帧先放入遥测队列，再由主程序或调度器任务调用Telemetry_Poll()转入串口发送队列。
+ * 两种方式都先确认剩余空间能放下整帧，放不下时丢弃整帧并计数，不会阻塞，也不会发送不完整的帧。
+ */
+#define TELEMETRY_QUEUE_SIZE 256 // 遥测队列大小（字节），必须是2的整数次幂，每帧占用 编码长度 + 1 字节
+
+#if (TELEMETRY_QUEUE_SIZE & (TELEMETRY_QUEUE_SIZE - 1)) != 0 || TELEMETRY_QUEUE_SIZE < TELEMETRY_COBS_MAX + 1 || TELEMETRY_COBS_MAX > 255
+#error "TELEMETRY_QUEUE_SIZE must be a power of two able to hold one frame! See Telemetry.h file."
+#endif
+
+void Telemetry_Init(void);                                                  // 初始化遥测发送（使能CRC时钟）。
+uint8_t Telemetry_Send(uint8_t Type, const uint8_t *Payload, uint8_t Len);  // 发送一条记录（主程序中调用）。
+uint8_t Telemetry_SendPID(const Telemetry_PID *Rec);                        // 发送一条PID采样记录（主程序中调用）。
+uint8_t Telemetry_Post(uint8_t Type, const uint8_t *Payload, uint8_t Len);  // 将一条记录放入遥测队列（中断中调用）。
+uint8_t Telemetry_PostPID(const Telemetry_PID *Rec);                        // 将一条PID采样记录放入遥测队列（中断中调用）。
+void Telemetry_Poll(void);                                                  // 将遥测队列中的帧转入串口发送队列（主程序中调用）。
+uint32_t Telemetry_GetDropCount(void);                                      // 获取因队列已满而丢弃的帧数。
+uint8_t Telemetry_SelfTest(void);                                           // 编码/解码回环自检。
+
+#endif
+
+/**
+  ***************************************************
+  * @example 遥测发送例程
+  * @brief   在控制周期（CtrlTick中断）中采样PID，由调度器任务发送，上位机用Telemetry/Host/telemetry_decode.c解码
+  ***************************************************
+    PID pid;
+
+    static void MotorLoop(void *Arg, float dt) // CtrlTick控制函数，在TIM3中断中运行
+    {
+        Telemetry_PID rec;
+        float feedback = Encoder_GetSpeed();
+        float output = PID_Compute_dt(&pid, feedback, dt);
+
+        Motor_SetPWM(output);
+
+        rec.Timestamp = (uint32_t)Delay_Micros();
+        rec.Setpoint = pid.target;
+        rec.Measurement = feedback;
+        rec.P = pid.Kp * pid.error;
+        rec.I = pid.Ki * pid.integral;
+        rec.D = pid.Kd * (pid.error - pid.last_error);
+        rec.Output = output;
+        Telemetry_PostPID(&rec); // 中断中只放入遥测队列
+    }
+
+    static void TelemetryTask(uint16_t Event)
+    {
+        Telemetry_Poll(); // 主程序中转入串口发送队列
+    }
+
+    UART_init(921600);
+    Telemetry_Init();
+    if (Telemetry_SelfTest() != 0)
+    {
+        // 自检失败：硬件CRC与软件CRC不一致或编解码错误
+    }
+    CtrlTick_Register(MotorLoop, 0);
+    CtrlTick_Init();
+    Sched_AddTask("telemetry", TelemetryTask, 1);
+    Sched_Run();
+
+    // 上位机（PC）：
+    //   gcc -ITelemetry Telemetry/Host/telemetry_decode.c Telemetry/Telemetry_Proto.c -o telemetry_decode
+    //   telemetry_decode < capture.bin > log.csv
+  ***************************************************
+  */
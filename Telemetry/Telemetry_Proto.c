@@ -0,0 +1,210 @@
+#include "Telemetry_Proto.h"
+#include "string.h"
+
+/**
+ * @brief  软件计算CRC32，结果与STM32硬件CRC单元相同（上位机解码及无硬件CRC时使用）。
+ * @param  Data 数据，按32位小端字计算。
+ * @param  Len 数据长度，必须是4的倍数。
+ * @retval CRC32值
+ */
+uint32_t Telemetry_CRC32(const uint8_t *Data, uint16_t Len)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    uint32_t word;
+    uint16_t i;
+    uint8_t bit;
+
+    for (i = 0; i + 4 <= Len; i += 4)
+    {
+        word = (uint32_t)Data[i] | ((uint32_t)Data[i + 1] << 8) |
+               ((uint32_t)Data[i + 2] << 16) | ((uint32_t)Data[i + 3] << 24);
+        crc ^= word;
+        for (bit = 0; bit < 32; bit++)
+            crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04C11DB7 : (crc << 1);
+    }
+    return crc;
+}
+
+/**
+ * @brief  COBS编码，编码结果中不含0x00，并在末尾添加帧结束符0x00。
+ * @param  Src 原始数据。
+ * @param  Len 原始数据长度。
+ * @param  Dst 编码结果，至少 Len + Len / 254 + 2 个字节。
+ * @retval 编码结果长度（含结尾0x00）。
+ */
+uint16_t Telemetry_COBSEncode(const uint8_t *Src, uint16_t Len, uint8_t *Dst)
+{
+    uint16_t code_pos = 0; // 当前分组长度字节的位置
+    uint16_t out = 1;
+    uint8_t code = 1;
+    uint16_t i;
+
+    for (i = 0; i < Len; i++)
+    {
+        if (Src[i] == 0)
+        {
+            Dst[code_pos] = code;
+            code_pos = out++;
+            code = 1;
+        }
+        else
+        {
+            Dst[out++] = Src[i];
+            if (++code == 0xFF) // 分组已满254个非零字节
+            {
+                Dst[code_pos] = code;
+                code_pos = out++;
+                code = 1;
+            }
+        }
+    }
+    Dst[code_pos] = code;
+    Dst[out++] = 0x00;
+    return out;
+}
+
+/**
+ * @brief  COBS解码（输入不含帧结束符0x00）。
+ * @param  Src 编码数据。
+ * @param  Len 编码数据长度。
+ * @param  Dst 解码结果，至少Len个字节。
+ * @retval 解码结果长度；数据中含0x00或分组长度越界时返回 -1。
+ */
+int16_t Telemetry_COBSDecode(const uint8_t *Src, uint16_t Len, uint8_t *Dst)
+{
+    uint16_t in = 0, out = 0;
+    uint8_t code, i;
+
+    while (in < Len)
+    {
+        code = Src[in++];
+        if (code == 0 || in + code - 1 > Len)
+            return -1;
+        for (i = 1; i < code; i++)
+        {
+            if (Src[in] == 0)
+                return -1;
+            Dst[out++] = Src[in++];
+        }
+        if (code != 0xFF && in < Len) // 非满分组后接一个被编码掉的0x00
+            Dst[out++] = 0;
+    }
+    return (int16_t)out;
+}
+
+/**
+ * @brief  按小端格式写入32位数据。
+ * @param  p 写入位置。
+ * @param  v 要写入的数据。
+ * @retval 无
+ */
+static void Telemetry_Put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * @brief  按小端格式读取32位数据。
+ * @param  p 读取位置。
+ * @retval 读取到的数据
+ */
+static uint32_t Telemetry_Get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief  按小端格式写入单精度浮点数。
+ * @param  p 写入位置。
+ * @param  f 要写入的数据。
+ * @retval 无
+ */
+static void Telemetry_PutFloat(uint8_t *p, float f)
+{
+    uint32_t v;
+    memcpy(&v, &f, 4);
+    Telemetry_Put32(p, v);
+}
+
+/**
+ * @brief  按小端格式读取单精度浮点数。
+ * @param  p 读取位置。
+ * @retval 读取到的数据
+ */
+static float Telemetry_GetFloat(const uint8_t *p)
+{
+    uint32_t v = Telemetry_Get32(p);
+    float f;
+    memcpy(&f, &v, 4);
+    return f;
+}
+
+/**
+ * @brief  将PID记录转换为负载数据。
+ * @param  Rec PID记录。
+ * @param  Payload 负载数据，至少TELEMETRY_PID_LEN个字节。
+ * @retval 负载长度
+ */
+uint8_t Telemetry_PackPID(const Telemetry_PID *Rec, uint8_t *Payload)
+{
+    Telemetry_Put32(Payload, Rec->Timestamp);
+    Telemetry_PutFloat(Payload + 4, Rec->Setpoint);
+    Telemetry_PutFloat(Payload + 8, Rec->Measurement);
+    Telemetry_PutFloat(Payload + 12, Rec->P);
+    Telemetry_PutFloat(Payload + 16, Rec->I);
+    Telemetry_PutFloat(Payload + 20, Rec->D);
+    Telemetry_PutFloat(Payload + 24, Rec->Output);
+    return TELEMETRY_PID_LEN;
+}
+
+/**
+ * @brief  将负载数据转换为PID记录。
+ * @param  Payload 负载数据。
+ * @param  Rec PID记录。
+ * @retval 无
+ */
+void Telemetry_UnpackPID(const uint8_t *Payload, Telemetry_PID *Rec)
+{
+    Rec->Timestamp = Telemetry_Get32(Payload);
+    Rec->Setpoint = Telemetry_GetFloat(Payload + 4);
+    Rec->Measurement = Telemetry_GetFloat(Payload + 8);
+    Rec->P = Telemetry_GetFloat(Payload + 12);
+    Rec->I = Telemetry_GetFloat(Payload + 16);
+    Rec->D = Telemetry_GetFloat(Payload + 20);
+    Rec->Output = Telemetry_GetFloat(Payload + 24);
+}
+
+/**
+ * @brief  解码一帧：COBS解码并校验长度与CRC。
+ * @param  Src 编码数据（两个0x00之间的部分，不含0x00）。
+ * @param  Len 编码数据长度。
+ * @param  Work 解码缓冲区，至少Len个字节，解码成功后Rec->Payload指向其中。
+ * @param  Rec 解码结果。
+ * @retval 状态值
+ *      - \b 0 : 成功
+ *      - \b -1 : COBS格式错误或长度错误
+ *      - \b -2 : CRC校验错误
+ */
+int8_t Telemetry_DecodeFrame(const uint8_t *Src, uint16_t Len, uint8_t *Work, Telemetry_Record *Rec)
+{
+    int16_t n = Telemetry_COBSDecode(Src, Len, Work);
+    uint16_t body;
+
+    if (n < TELEMETRY_HEADER_LEN + 4)
+        return -1;
+    body = (uint16_t)n - 4;
+    if (Work[2] != body - TELEMETRY_HEADER_LEN || (body & 3) != 0)
+        return -1;
+    if (Telemetry_CRC32(Work, body) != Telemetry_Get32(Work + body))
+        return -2;
+
+    Rec->Version = Work[0];
+    Rec->Type = Work[1];
+    Rec->Len = Work[2];
+    Rec->Seq = Work[3];
+    Rec->Payload = Work + TELEMETRY_HEADER_LEN;
+    return 0;
+}
@@ -0,0 +1,59 @@
+#ifndef __TELEMETRY_PROTO_H
+#define __TELEMETRY_PROTO_H
+
+#include "stdint.h"
+
+/**
+ * 二进制遥测协议（与硬件无关，单片机与上位机共用）。
+ *
+ * 一帧数据（COBS编码前）:
+ *   | 版本 | 类型 | 负载长度 | 序号 | 负载（长度为4的倍数） | CRC32 |
+ *   |  1B  |  1B  |    1B    |  1B  |          N B           |  4B   |
+ *   多字节数据均为小端格式，浮点数为IEEE754单精度。
+ *   CRC32与STM32硬件CRC单元一致：多项式0x04C11DB7，初值0xFFFFFFFF，不反转，不异或，
+ *   按32位小端字逐字计算（覆盖帧头和负载）。
+ * 帧经COBS编码后以一个0x00字节结尾，接收端以0x00划分帧，丢失字节后可从下一个0x00处重新同步。
+ */
+#define TELEMETRY_VERSION 1 // 协议版本，记录格式不兼容地修改时加1
+
+#define TELEMETRY_HEADER_LEN 4                                         // 帧头长度
+#define TELEMETRY_PAYLOAD_MAX 64                                       // 负载最大长度
+#define TELEMETRY_FRAME_MAX (TELEMETRY_HEADER_LEN + TELEMETRY_PAYLOAD_MAX + 4) // COBS编码前帧的最大长度
+#define TELEMETRY_COBS_MAX (TELEMETRY_FRAME_MAX + TELEMETRY_FRAME_MAX / 254 + 2) // COBS编码后（含结尾0x00）的最大长度
+
+// 记录类型
+#define TELEMETRY_TYPE_PID 0x01 // PID控制环采样
+
+// PID控制环采样记录，负载28字节，编码后一帧共38字节，921600波特率下每秒约2400帧
+typedef struct
+{
+    uint32_t Timestamp;   // 时间戳（单位由发送方决定，如微秒）
+    float Setpoint;       // 目标值
+    float Measurement;    // 测量值
+    float P, I, D;        // 比例、积分、微分项
+    float Output;         // 输出值
+} Telemetry_PID;
+
+#define TELEMETRY_PID_LEN 28 // Telemetry_PID负载长度
+
+// 解码结果
+typedef struct
+{
+    uint8_t Version; // 协议版本
+    uint8_t Type;    // 记录类型
+    uint8_t Seq;     // 序号，可用于检测丢帧
+    uint8_t Len;     // 负载长度
+    const uint8_t *Payload; // 负载数据（指向解码缓冲区）
+} Telemetry_Record;
+
+uint32_t Telemetry_CRC32(const uint8_t *Data, uint16_t Len); // 软件计算CRC32（与STM32硬件CRC一致）。
+
+uint16_t Telemetry_COBSEncode(const uint8_t *Src, uint16_t Len, uint8_t *Dst); // COBS编码。
+int16_t Telemetry_COBSDecode(const uint8_t *Src, uint16_t Len, uint8_t *Dst);  // COBS解码。
+
+uint8_t Telemetry_PackPID(const Telemetry_PID *Rec, uint8_t *Payload);   // 将PID记录转换为负载数据。
+void Telemetry_UnpackPID(const uint8_t *Payload, Telemetry_PID *Rec);    // 将负载数据转换为PID记录。
+
+int8_t Telemetry_DecodeFrame(const uint8_t *Src, uint16_t Len, uint8_t *Work, Telemetry_Record *Rec); // 解码一帧。
+
+#endif
@@ -1,17 +1,36 @@
 #include "stm32f10x.h"
 #include "delay.h"
+#include "fault.h"
 #include "OLED.h"
 #include "USART.h"
+#include "sched.h"
+#include "pt.h"
 
-int main(void)
+#define EVT_UART_RX 1    // 串口收到数据
+#define EVT_INTRO_DONE 2 // 启动画面结束
+
+static int8_t IntroTask, EchoTask; // 任务号
+static PT IntroPt, OledPt, EchoPt;  // 协程状态
+
+/**
+ * @brief  启动画面协程：初始化OLED、显示进度条、启动滚动，等待期间不占用CPU
+ * @param  pt 协程状态
+ * @retval PT_WAITING或PT_ENDED
+ */
+static uint8_t IntroThread(PT *pt)
 {
-    OLED_Init();
-    UART_init(115200);
+    static int i; // 跨越等待的变量必须为static
+    int j;
+
+    PT_BEGIN(pt);
+
+    PT_INIT(&OledPt);
+    PT_AWAIT_THREAD(pt, OLED_Init_PT(&OledPt));
 
     OLED_ShowString(1, 1, " UART OLED TEST ", 8);
     OLED_ShowString(3, 1, "================", 8);
 
-    Delay_ms(1000);
+    PT_AWAIT_TICKS(pt, 1000);
 
     /* 设置OLED反显 */
     OLED_SetDisplayMode(NEGATIVE_MODE);
@@ -25,7 +44,7 @@ int main(void)
     OLED_WriteData(0xFF);
     OLED_SetCursor(5, 120);
     OLED_WriteData(0xFF);
-    for(int j = 0; j < 111; j++)
+    for (j = 0; j < 111; j++)
     {
         OLED_SetCursor(4, 9 + j);
         OLED_WriteData(0x01);
@@ -33,38 +52,105 @@ int main(void)
         OLED_WriteData(0x80);
     }
 
-    Delay_ms(500);
+    PT_AWAIT_TICKS(pt, 500);
 
     /* 模拟进度条加载 */
-    int i;
     for (i = 2; i < 111; i++)
     {
         OLED_SetCursor(4, 8 + i);
         OLED_WriteData(0xFD);
         OLED_SetCursor(5, 8 + i);
         OLED_WriteData(0xBF);
-        Delay_ms(i - i / 2 + 1);
+        PT_AWAIT_TICKS(pt, i - i / 2 + 1);
     }
     OLED_ShowString(5, 1, "     FINISH     ", 8);
-    Delay_ms(1000);
+    PT_AWAIT_TICKS(pt, 1000);
     OLED_ClearLine(5, 6);
 
     /* 第一行文字右上滚动显示 */
+    PT_WAIT_UNTIL(pt, OLED_ScrollSettled());
     OLED_Scroll_VH(1, 16, ScrH_ON, ScrVR, 1, 2, 1, 128, 1, OLED_ScrSpeed5);
 
+    Sched_Post(EchoTask, EVT_INTRO_DONE);
+    PT_END(pt);
+}
+
+/**
+ * @brief  串口回显协程：启动画面结束后，每收到一行数据原样返回，并显示在OLED上
+ * @param  pt 协程状态
+ * @param  Event 事件值
+ * @retval PT_WAITING或PT_ENDED
+ */
+static uint8_t EchoThread(PT *pt, uint16_t Event)
+{
+    uint8_t t;
+
+    PT_BEGIN(pt);
+
+    PT_WAIT_UNTIL(pt, Event == EVT_INTRO_DONE); // 启动期间收到的数据保留在接收缓冲区中
     while (1)
     {
-        // 串口收发测试
-        if (get_UART_RecStatus())
+        while (get_UART_RecStatus()) // 一次空闲中断可能带来多行数据，全部取完再等待下一个事件
         {
-            uint8_t t;
             OLED_ClearLine(5, 6);
+            UART_Write(USART_RX_BUF, get_UART_RecLength()); // 放入发送队列，由DMA在后台发送
             for (t = 0; t < get_UART_RecLength(); t++)
             {
-                UART_SendData(USART_RX_BUF[t]);
                 OLED_ShowChar(5, (t * 8 + 1), USART_RX_BUF[t], 8);
             }
             Reset_UART_RecStatus();
         }
+        PT_AWAIT_EVENT(pt, Event, EVT_UART_RX);
     }
+
+    PT_END(pt);
+}
+
+/**
+ * @brief  启动画面任务，每个节拍运行一次协程，结束后停止周期运行
+ * @param  Event 事件值
+ * @retval 无
+ */
+static void Intro(uint16_t Event)
+{
+    (void)Event;
+    if (IntroThread(&IntroPt) == PT_ENDED)
+        Sched_SetPeriod(IntroTask, 0);
+}
+
+/**
+ * @brief  串口回显任务，只由事件触发
+ * @param  Event 事件值
+ * @retval 无
+ */
+static void Echo(uint16_t Event)
+{
+    EchoThread(&EchoPt, Event);
+}
+
+/**
+ * @brief  串口收到数据（中断中调用），投递事件唤醒回显任务
+ * @param  无
+ * @retval 无
+ */
+static void UART_OnReceive(void)
+{
+    Sched_Post(EchoTask, EVT_UART_RX);
+}
+
+int main(void)
+{
+    NVIC_PriorityGroupConfig(NVIC_PriorityGroup_2); // 2位抢占优先级（0 ~ 3）、2位响应优先级，须在各模块调用NVIC_Init之前设置
+    Delay_Init();
+    Fault_Init();
+    UART_init(115200);
+    Fault_Report(UART_printf); // 输出上次故障复位前记录的现场
+
+    PT_INIT(&IntroPt);
+    PT_INIT(&EchoPt);
+    IntroTask = Sched_AddTask("intro", Intro, 1);
+    EchoTask = Sched_AddTask("echo", Echo, 0);
+    UART_SetRxCallback(UART_OnReceive);
+
+    Sched_Run(); // 空闲时CPU睡眠，控制任务可与启动画面、串口回显交替运行
 }